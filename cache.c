@@ -0,0 +1,319 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Function-level build cache.
+// With `-C`, the output for each function definition (its string literals
+// and its code) is saved in a file in `CACHEDIR`. The file is named after a
+// hash of everything that the output depends on:
+//
+// - the function's tokens, from its type to its closing `}`
+// - its local symbols, and each global symbol that its tree refers to
+//
+// When a later compile finds the same key, the saved output is copied into
+// `out.s` and `genAST()` isn't run. The function is still parsed, so the
+// symbol table and the error checking are the same as in a clean build. As
+// labels are numbered afresh in each function, the output is the same as
+// that of a clean build.
+//
+// String literals are the exception: their labels are numbered across the
+// program, so they depend on what came before the function. The saved
+// output refers to each literal by its position among the function's
+// literals instead, `.LS0` for the first and so on, and these are turned
+// back into labels when the output is copied.
+//
+// A cache file holds `CACHEMAGIC`, `CACHEVERSION`, the key's length and the
+// key itself (so that a hash collision isn't mistaken for a hit), then the
+// length and characters of the function's output in each section.
+
+#define CACHEDIR "out.cache"
+#define CACHEMAGIC 0x48434142  // "BACH" in little-endian order
+#define CACHEVERSION 5
+
+enum {
+  NOCAPTURE,  // Not capturing a function's output
+  CAPTURING,  // Capturing, but the cache hasn't been looked at yet
+  CACHEHIT,   // The function's output was found in the cache
+  CACHEMISS   // The function's code is being generated, to be saved
+};
+
+static int Cachestate = NOCAPTURE;
+static struct output *Realout;  // `Output` while a function's output is captured
+static struct output *Capture;  // The captured output
+static int Starttoken;          // Position in `Tokens[]` of the function's first token
+static unsigned char *Key;      // The cache key being built
+static int Keylen;              // Its length
+static int Keycap;              // and the capacity of `Key[]`
+static char Cachename[64];      // Name of the cache file for the key
+static unsigned char *Entry;    // Contents of the cache file that was found
+static int Entrycap;            // Capacity of `Entry[]`
+static char *Hitout[NSECTIONS];  // The saved output of each section in `Entry[]`, on a hit
+static int Hitlen[NSECTIONS];    // and their lengths
+static int *Strlabels;          // The labels of the function's string literals, in order
+static int Nstrlabels;          // Number of entries in `Strlabels[]`
+static int Strlabelcap;         // and its capacity
+
+// Set up the cache directory
+void open_cache(void) {
+  if (mkdir(CACHEDIR, 0777) == -1 && errno != EEXIST) {
+    fprintf(stderr, "Unable to create %s: %s\n", CACHEDIR, strerror(errno));
+    exit(1);
+  }
+}
+
+// Append `n` bytes to the key
+static void keybytes(void *p, int n) {
+  if (Keylen + n > Keycap) {
+    Keycap = (Keycap ? Keycap * 2 : 4096) + n;
+    if ((Key = realloc(Key, Keycap)) == NULL)
+      fatal("Unable to `realloc` in `keybytes()`");
+  }
+
+  memcpy(Key + Keylen, p, n);
+  Keylen += n;
+}
+
+// Append an integer to the key
+static void keyint(int i) {
+  keybytes(&i, sizeof(int));
+}
+
+// Append a string, and its length, to the key
+static void keystring(char *s) {
+  int len = strlen(s);
+
+  keyint(len);
+  keybytes(s, len);
+}
+
+// Append the parts of a symbol that code generation uses to the key
+static void keysymbol(int slot) {
+  struct symtable *sym = SYMBOL(slot);
+
+  keystring(sym->name);
+  keyint(sym->type);
+  keyint(sym->stype);
+  keyint(sym->class);
+  keyint(sym->endlabel);
+  keyint(sym->size);
+  keyint(sym->numelems);
+  keyint(sym->shadowed);
+  keyint(sym->scopestart);
+  keyint(sym->scopeend);
+}
+
+// Add the label of the function's next string literal to `Strlabels[]`
+static void addstrlabel(int label) {
+  if (Nstrlabels == Strlabelcap) {
+    Strlabelcap = Strlabelcap ? Strlabelcap * 2 : 64;
+    if ((Strlabels = realloc(Strlabels, Strlabelcap * sizeof(int))) == NULL)
+      fatal("Unable to `realloc` in `addstrlabel()`");
+  }
+  Strlabels[Nstrlabels++] = label;
+}
+
+// Copy `n` characters of output from `s` to `o`, changing each string
+// literal's label into its position in `Strlabels[]` if `save` is set, or
+// each position back into the label if not. If `o` is NULL, only check
+// that each one can be changed. Return false if one can't.
+static int relabel(struct outbuf *o, char *s, int n, int save) {
+  char *p, *end = s + n;
+  char num[16];
+  long l;
+  int i;
+
+  for (p = s; end - p > 3; p++) {
+    if (memcmp(p, ".LS", 3) || !isdigit((unsigned char)p[3]))
+      continue;
+
+    // Copy up to the number, then replace it
+    p += 3;
+    if (o != NULL)
+      outwrite(o, s, p - s);
+    for (l = 0; p < end && isdigit((unsigned char)*p) && l <= INT_MAX; p++)
+      l = l * 10 + (*p - '0');
+    if (save) {
+      for (i = 0; i < Nstrlabels && Strlabels[i] != l; i++)
+        ;
+      if (i == Nstrlabels)
+        return 0;
+    } else {
+      if (l >= Nstrlabels)
+        return 0;
+      i = Strlabels[l];
+    }
+    if (o != NULL)
+      outwrite(o, num, snprintf(num, sizeof(num), "%d", i));
+    s = p--;
+  }
+
+  if (o != NULL)
+    outwrite(o, s, end - s);
+  return 1;
+}
+
+// Build the key for the function which has just been parsed into `tree`
+static void makekey(int tree) {
+  struct ASTnode *node;
+  struct token *t;
+  int i, nwords = ASTsize();
+
+  Keylen = 0;
+  Nstrlabels = 0;
+  keyint(CACHEVERSION);
+
+  // Its tokens, up to the one after the closing `}`
+  for (i = Starttoken; i < Tokpos - 1; i++) {
+    t = &Tokens[i];
+    keyint(t->token);
+    if (t->token == T_INTLIT)
+      keyint(t->intvalue);
+    else if (t->token == T_IDENT)
+      keystring(Names[t->nameid]);
+    else if (t->token == T_STRLIT) {
+      keystring(Names[t->nameid]);
+      addstrlabel(t->nameid);
+    }
+  }
+
+  // Its locals and the globals that it uses
+  keyint(Locals);
+  for (i = 0; i < Locals; i++)
+    keysymbol(LOCALSYM | i);
+  keyint(tree);
+  for (i = NOAST + 2; i < nwords; i += 2 + (node->flags & AST_NCHILD)) {
+    node = ASTNODE(i);
+    if (hassymbol(node->op) && !(node->v.id & LOCALSYM))
+      keysymbol(node->v.id);
+  }
+}
+
+// Return the FNV-1a hash of the key
+static unsigned long long keyhash(void) {
+  unsigned long long h = 0xcbf29ce484222325ULL;
+
+  for (int i = 0; i < Keylen; i++)
+    h = (h ^ Key[i]) * 0x100000001b3ULL;
+  return h;
+}
+
+// Read the cache file for the key into `Entry[]`. Return true if it holds
+// the key, and point `Hitout[]` at its output.
+static int readentry(void) {
+  int *hdr, n, pos;
+  FILE *fh;
+  struct stat sb;
+
+  if ((fh = fopen(Cachename, "rb")) == NULL)
+    return 0;
+
+  if (fstat(fileno(fh), &sb) == -1) {
+    fclose(fh);
+    return 0;
+  }
+
+  if (sb.st_size > Entrycap) {
+    Entrycap = sb.st_size;
+    if ((Entry = realloc(Entry, Entrycap)) == NULL)
+      fatal("Unable to `realloc` in `readentry()`");
+  }
+  n = fread(Entry, 1, sb.st_size, fh);
+  fclose(fh);
+
+  // Check the header and the key, then find each section's output after them
+  hdr = (int *)Entry;
+  if (n != sb.st_size || n < 3 * sizeof(int) || hdr[0] != CACHEMAGIC || hdr[1] != CACHEVERSION ||
+      hdr[2] != Keylen || n < 3 * sizeof(int) + Keylen || memcmp(Entry + 3 * sizeof(int), Key, Keylen))
+    return 0;
+
+  pos = 3 * sizeof(int) + Keylen;
+  for (int i = 0; i < NSECTIONS; i++) {
+    if (n - pos < sizeof(int))
+      return 0;
+    memcpy(&Hitlen[i], Entry + pos, sizeof(int));
+    pos += sizeof(int);
+    if (Hitlen[i] < 0 || Hitlen[i] > n - pos)
+      return 0;
+    Hitout[i] = (char *)Entry + pos;
+    pos += Hitlen[i];
+    if (!relabel(NULL, Hitout[i], Hitlen[i], 0))
+      return 0;
+  }
+
+  return pos == n;
+}
+
+// Save the captured output under the key. It's written to a temporary
+// file which is then renamed, so a reader never sees a partial entry.
+static void writeentry(void) {
+  char tmpname[sizeof(Cachename) + 16];
+  int hdr[3] = {CACHEMAGIC, CACHEVERSION, Keylen};
+  struct outbuf *saved[NSECTIONS];
+  int i, len, ok = 1;
+  FILE *fh;
+
+  // The output, with the string literals' labels taken out
+  for (i = 0; i < NSECTIONS; i++) {
+    saved[i] = newoutbuf();
+    ok = ok && relabel(saved[i], Capture->sec[i]->buf, Capture->sec[i]->len, 1);
+  }
+
+  snprintf(tmpname, sizeof(tmpname), "%s.%d", Cachename, (int)getpid());
+  if (ok && (fh = fopen(tmpname, "wb")) != NULL) {  // The cache is only an optimisation
+    fwrite(hdr, sizeof(int), 3, fh);
+    fwrite(Key, 1, Keylen, fh);
+    for (i = 0; i < NSECTIONS; i++) {
+      len = saved[i]->len;
+      fwrite(&len, sizeof(int), 1, fh);
+      fwrite(saved[i]->buf, 1, len, fh);
+    }
+    if (ferror(fh) | fclose(fh) || rename(tmpname, Cachename) == -1)
+      remove(tmpname);
+  }
+
+  for (i = 0; i < NSECTIONS; i++)
+    freeoutbuf(saved[i]);
+}
+
+// Start capturing the output of a function definition, whose first
+// token is at position `start` in `Tokens[]`
+void cachebegin(int start) {
+  Starttoken = start;
+  Realout = Output;
+  useoutput(Capture = newoutput(-1));
+  Cachestate = CAPTURING;
+}
+
+// The function has been parsed into `tree`. Return true if its output
+// was found in the cache, so there is no need to call `genAST()`.
+int cachelookup(int tree) {
+  makekey(tree);
+  snprintf(Cachename, sizeof(Cachename), "%s/%016llx", CACHEDIR, keyhash());
+
+  Cachestate = readentry() ? CACHEHIT : CACHEMISS;
+  return Cachestate == CACHEHIT;
+}
+
+// Finish with the function: add its output to the real output, and save it
+// in the cache if it was generated
+void cacheend(void) {
+  useoutput(Realout);
+
+  if (Cachestate == CACHEHIT) {
+    for (int i = 0; i < NSECTIONS; i++)
+      relabel(Realout->sec[i], Hitout[i], Hitlen[i], 0);
+  } else {
+    appendoutput(Realout, Capture);
+    if (Cachestate == CACHEMISS)
+      writeentry();
+  }
+
+  freeoutput(Capture);
+  Capture = NULL;
+  Cachestate = NOCAPTURE;
+}
@@ -4,129 +4,204 @@
 
 // Generic code generator
 
+static _Thread_local int Nextlabel = 1;  // The next label number in the current function
+
 // Generate and return a new label number
-int genlabel(void) {
-  static int id = 1;
-  return id++;
+int genlabel(void) { return Nextlabel++; }
+
+// Start numbering labels from 1 again for a new function. Label names
+// include the function's name, so a function's code doesn't depend on
+// how many labels the functions before it used.
+void genresetlabels(void) { Nextlabel = 1; }
+
+// The code generator doesn't recurse. Each node being generated has a frame
+// on `Genstack[]` recording how far through the node it has got. A child is
+// generated by pushing a frame for it, and when the child's frame is popped
+// the register holding its value is handed back to the parent.
+
+struct genframe {
+  int n;            // The node being generated
+  int label;        // Label passed down from the parent
+  int parentASTop;  // AST op of the parent
+  int step;         // How far through the node's children we are
+  int leftreg;      // Register holding the left child's value
+  int aux[2];       // For `A_FUNCCALL`: the argument walk
+};
+
+#define INITIAL_GENFRAMES 64  // Initial capacity of `Genstack[]`
+
+static _Thread_local struct genframe *Genstack;  // Frames of the nodes being generated
+static _Thread_local int Gendepth;               // Number of frames in use
+static _Thread_local int Gencap;                 // Capacity of `Genstack[]`
+
+// Push a frame to generate the code for node `n`. Any frame pointer held by
+// the caller may be moved by this.
+static void genpush(int n, int label, int parentASTop) {
+  struct genframe *f;
+
+  if (Gendepth == Gencap) {
+    Gencap = Gencap ? Gencap * 2 : INITIAL_GENFRAMES;
+    if ((Genstack = realloc(Genstack, Gencap * sizeof(struct genframe))) == NULL)
+      fatal("Unable to `realloc` in `genpush()`");
+  }
+
+  f = &Genstack[Gendepth++];
+  f->n = n;
+  f->label = label;
+  f->parentASTop = parentASTop;
+  f->step = 0;
 }
 
-// Generate the code for an IF statement and an optional ELSE clause
-static int genIF(struct ASTnode *n) {
-  int Lfalse, Lend;
+// Pop the frame of a finished node, returning the register with its value
+static int genpop(int reg) {
+  Gendepth--;
+  return reg;
+}
 
-  // Generate 2 labels: one for the false compound statement, and one for the
-  // end of the overall IF statement. When no ELSE, `Lfalse` is the ending
-  // label.
-  Lfalse = genlabel();
-  if (n->right)
-    Lend = genlabel();
+// Generate the code for an IF statement and an optional ELSE clause.
+// The parser gave it 2 labels: one for the false compound statement, and one
+// for the end of the overall IF statement. When no ELSE, `Lfalse` is the
+// ending label.
+static int genIF(struct genframe *f, int reg) {
+  int n = f->n;
+  int Lfalse = ASTNODE(n)->v.label, Lend = Lfalse + 1;
+
+  switch (f->step++) {
+    case 0:
+      // Generate the condition code, followed by a zero jump to `Lfalse`.
+      // We cheat by sending the `Lfalse` label as a register.
+      genpush(ASTLEFT(n), Lfalse, A_IF);
+      return NOREG;
 
-  // Generate the condition code, followed by a zero jump to `Lfalse`.
-  // We cheat by sending the `Lfalse` label as a register.
-  genAST(n->left, Lfalse, n->op);
-  genfreeregs();
+    case 1:
+      genfreeregs();
 
-  // Generate the true compound statement
-  genAST(n->mid, NOLABEL, n->op);
-  genfreeregs();
+      // Generate the true compound statement
+      genpush(ASTMID(n), NOLABEL, A_IF);
+      return NOREG;
 
-  // If ELSE clause, generate the jump to skip to the end
-  if (n->right)
-    cgjump(Lend);
+    case 2:
+      genfreeregs();
 
-  cglabel(Lfalse);
+      // If ELSE clause, generate the jump to skip to the end
+      if (ASTRIGHT(n))
+        cgjump(Lend);
 
-  // If ELSE clause, generate the false compound statement and `Lend` label
-  if (n->right) {
-    genAST(n->right, NOLABEL, n->op);
-    genfreeregs();
-    cglabel(Lend);
-  }
+      cglabel(Lfalse);
 
-  return NOREG;
+      // If ELSE clause, generate the false compound statement and `Lend` label
+      if (ASTRIGHT(n)) {
+        genpush(ASTRIGHT(n), NOLABEL, A_IF);
+        return NOREG;
+      }
+      return genpop(NOREG);
+
+    default:
+      genfreeregs();
+      cglabel(Lend);
+      return genpop(NOREG);
+  }
 }
 
-// Generate the code for a WHILE statement and an optional ELSE clause
-static int genWHILE(struct ASTnode *n) {
-  int Lstart = genlabel();
-  int Lend = genlabel();
+// Generate the code for a WHILE statement, using the 2 labels
+// that the parser gave it for the start and the end of the loop
+static int genWHILE(struct genframe *f, int reg) {
+  int n = f->n;
+  int Lstart = ASTNODE(n)->v.label, Lend = Lstart + 1;
+
+  switch (f->step++) {
+    case 0:
+      cglabel(Lstart);
 
-  cglabel(Lstart);
+      // Generate condition code followed by a zero jump to `Lend`.
+      // We cheat by sending the `Lend` label as a register.
+      genpush(ASTLEFT(n), Lend, A_WHILE);
+      return NOREG;
 
-  // Generate condition code followed by a zero jump to `Lend`.
-  // We cheat by sending the `Lend` label as a register.
-  genAST(n->left, Lend, n->op);
-  genfreeregs();
+    case 1:
+      genfreeregs();
 
-  // Generate the compound statement in the loop body
-  genAST(n->right, NOLABEL, n->op);
-  genfreeregs();
+      // Generate the compound statement in the loop body
+      genpush(ASTRIGHT(n), NOLABEL, A_WHILE);
+      return NOREG;
 
-  cgjump(Lstart);  // Jump back to condition
-  cglabel(Lend);   // Jump here when condition is false
+    default:
+      genfreeregs();
 
-  return NOREG;
+      cgjump(Lstart);  // Jump back to condition
+      cglabel(Lend);   // Jump here when condition is false
+      return genpop(NOREG);
+  }
 }
 
 // Generate code to copy the arguments of a function call to its parameters.
 // Then, call the function itself. Return the register with the return value.
-static int gen_funccall(struct ASTnode *n) {
-  struct ASTnode *gluetree = n->left;
-  int reg, numargs = 0;
+static int gen_funccall(struct genframe *f, int reg) {
+  int *gluetree = &f->aux[0], *numargs = &f->aux[1];
 
-  // If there's a list of arguments, walk it from the last argument (right child) to the first
-  while (gluetree) {
-    reg = genAST(gluetree->right, NOLABEL, gluetree->op);
-    cgcopyarg(reg, gluetree->v.size);
+  if (f->step++ == 0) {
+    *gluetree = ASTLEFT(f->n);
+    *numargs = 0;
+  } else {
+    // Copy the value of the argument which has just been generated
+    cgcopyarg(reg, ASTNODE(*gluetree)->v.size);
 
-    if (numargs == 0)  // Keep the first (highest) number of arguments
-      numargs = gluetree->v.size;
+    if (*numargs == 0)  // Keep the first (highest) number of arguments
+      *numargs = ASTNODE(*gluetree)->v.size;
 
     genfreeregs();
-    gluetree = gluetree->left;
+    *gluetree = ASTLEFT(*gluetree);
+  }
+
+  // If there's a list of arguments, walk it from the last argument (right child) to the first
+  if (*gluetree) {
+    genpush(ASTRIGHT(*gluetree), NOLABEL, A_GLUE);
+    return NOREG;
   }
 
   // Call the function, clean up the stack (based on number of arguments), and return its result
-  return cgcall(n->v.id, numargs);
+  return genpop(cgcall(ASTNODE(f->n)->v.id, *numargs));
 }
 
-// Given an AST node, the register (if any) holding the previous rvalue, and the
-// AST op of the parent, recursively generate assembly code. Return the register
-// with the final tree value.
-int genAST(struct ASTnode *n, int label, int parentASTop) {
-  int leftreg, rightreg;
-
-  // Specific AST node handling
-  switch (n->op) {
-    case A_IF:
-      return genIF(n);
-    case A_WHILE:
-      return genWHILE(n);
-    case A_FUNCCALL:
-      return gen_funccall(n);
-    case A_GLUE:
-      // Do each child statement. Free the registers after each child.
-      genAST(n->left, NOLABEL, n->op);
-      genfreeregs();
-      genAST(n->right, NOLABEL, n->op);
-      genfreeregs();
+// Generate the code for each child statement of an `A_GLUE` node.
+// Free the registers after each child.
+static int genGLUE(struct genframe *f, int reg) {
+  switch (f->step++) {
+    case 0:
+      genpush(ASTLEFT(f->n), NOLABEL, A_GLUE);
       return NOREG;
-    case A_FUNCTION:
-      cgfuncpreamble(n->v.id);
-      genAST(n->left, NOLABEL, n->op);
-      cgfuncpostamble(n->v.id);
+    case 1:
+      genfreeregs();
+      genpush(ASTRIGHT(f->n), NOLABEL, A_GLUE);
       return NOREG;
+    default:
+      genfreeregs();
+      return genpop(NOREG);
   }
+}
 
-  // General AST node handling
+// Generate the code for a function. It starts with all the registers free,
+// whatever the function before it left, so the code doesn't depend on which
+// thread generates it.
+static int genFUNCTION(struct genframe *f, int reg) {
+  if (f->step++ == 0) {
+    genfreeregs();
+    cgfuncpreamble(ASTNODE(f->n)->v.id);
+    genpush(ASTLEFT(f->n), NOLABEL, A_FUNCTION);
+    return NOREG;
+  }
 
-  // Get left and right sub-tree values
-  if (n->left)
-    leftreg = genAST(n->left, NOLABEL, n->op);
-  if (n->right)
-    rightreg = genAST(n->right, NOLABEL, n->op);
+  cgfuncpostamble(ASTNODE(f->n)->v.id);
+  return genpop(NOREG);
+}
 
-  switch (n->op) {
+// Given an AST node, the registers holding its children's values, the label
+// passed down and the AST op of the parent, generate the code for the node's
+// own operation. Return the register with the node's value.
+static int genop(int n, int leftreg, int rightreg, int label, int parentASTop) {
+  struct ASTnode *node = ASTNODE(n);
+
+  switch (node->op) {
     case A_ADD:
       return cgadd(leftreg, rightreg);
     case A_SUBTRACT:
@@ -154,49 +229,49 @@ int genAST(struct ASTnode *n, int label, int parentASTop) {
       // If parent AST node is A_IF or A_WHILE, generate a compare followed by a jump.
       // Otherwise, compare registers and set one to 1 or 0 based on the comparison.
       if (parentASTop == A_IF || parentASTop == A_WHILE)
-        return cgcompare_and_jump(n->op, leftreg, rightreg, label);
+        return cgcompare_and_jump(node->op, leftreg, rightreg, label);
       else
-        return cgcompare_and_set(n->op, leftreg, rightreg);
+        return cgcompare_and_set(node->op, leftreg, rightreg);
     case A_INTLIT:
-      return cgloadint(n->v.intvalue, n->type);
+      return cgloadint(node->v.intvalue, node->type);
     case A_STRLIT:
-      return cgloadglobalstr(n->v.id);
+      return cgloadglobalstr(node->v.id);
     case A_IDENT:
       // Load value if an r-value or are being dereferenced
-      if (n->rvalue || parentASTop == A_DEREF)
-        return (Symtable[n->v.id].class == C_LOCAL)
-                   ? cgloadlocal(n->v.id, n->op)
-                   : cgloadglobal(n->v.id, n->op);
+      if ((node->flags & AST_RVALUE) || parentASTop == A_DEREF)
+        return (SYMBOL(node->v.id)->class == C_LOCAL)
+                   ? cgloadlocal(node->v.id, node->op)
+                   : cgloadglobal(node->v.id, node->op);
       else
         return NOREG;
     case A_ASSIGN:
       // Are we assigning to an identifier or through a pointer?
-      switch (n->right->op) {
+      switch (ASTNODE(ASTRIGHT(n))->op) {
         case A_IDENT:
-          return (Symtable[n->right->v.id].class == C_LOCAL)
-                     ? cgstorlocal(leftreg, n->right->v.id)
-                     : cgstoreglobal(leftreg, n->right->v.id);
+          return (SYMBOL(ASTNODE(ASTRIGHT(n))->v.id)->class == C_LOCAL)
+                     ? cgstorlocal(leftreg, ASTNODE(ASTRIGHT(n))->v.id)
+                     : cgstoreglobal(leftreg, ASTNODE(ASTRIGHT(n))->v.id);
         case A_DEREF:
-          return cgstorederef(leftreg, rightreg, n->right->type);
+          return cgstorederef(leftreg, rightreg, ASTNODE(ASTRIGHT(n))->type);
         default:
-          fatald("Can't `A_ASSIGN` in `genAST()`, op", n->op);
+          fatald("Can't `A_ASSIGN` in `genAST()`, op", node->op);
       }
     case A_WIDEN:  // `cgwiden()` does nothing, but leave this node for other hardware platforms
       // Widen child's type to the parent's type
-      return cgwiden(leftreg, n->left->type, n->type);
+      return cgwiden(leftreg, ASTNODE(ASTLEFT(n))->type, node->type);
     case A_RETURN:
       cgreturn(leftreg, Functionid);
       return NOREG;
     case A_ADDR:
-      return cgaddress(n->v.id);
+      return cgaddress(node->v.id);
     case A_DEREF:
-      if (n->rvalue)  // Dereference to get the value pointed at
-        return cgderef(leftreg, n->left->type);
+      if ((node->flags & AST_RVALUE))  // Dereference to get the value pointed at
+        return cgderef(leftreg, ASTNODE(ASTLEFT(n))->type);
       else  // Leave for `A_ASSIGN` to store through the pointer
         return leftreg;
     case A_SCALE:
       // Small optimization: use bit-shift if scale value is a known power of 2
-      switch (n->v.size) {
+      switch (node->v.size) {
         case 2:
           return cgshlconst(leftreg, 1);
         case 4:
@@ -205,17 +280,17 @@ int genAST(struct ASTnode *n, int label, int parentASTop) {
           return cgshlconst(leftreg, 3);
         default:
           // Load a register with the size and multiple `leftreg` by it
-          rightreg = cgloadint(n->v.size, P_INT);
+          rightreg = cgloadint(node->v.size, P_INT);
           return cgmul(leftreg, rightreg);
       }
     case A_POSTINC:
-      return cgloadglobal(n->v.id, n->op);
+      return cgloadglobal(node->v.id, node->op);
     case A_POSTDEC:
-      return cgloadglobal(n->v.id, n->op);
+      return cgloadglobal(node->v.id, node->op);
     case A_PREINC:
-      return cgloadglobal(n->left->v.id, n->op);
+      return cgloadglobal(ASTNODE(ASTLEFT(n))->v.id, node->op);
     case A_PREDEC:
-      return cgloadglobal(n->left->v.id, n->op);
+      return cgloadglobal(ASTNODE(ASTLEFT(n))->v.id, node->op);
     case A_NEGATE:
       return cgnegate(leftreg);
     case A_INVERT:
@@ -228,23 +303,111 @@ int genAST(struct ASTnode *n, int label, int parentASTop) {
       // to 0 or 1 based on it's zero-ness or non-zero-ness.
       return cgboolean(leftreg, parentASTop, label);
     default:
-      fatald("Unknown AST operator", n->op);
+      fatald("Unknown AST operator", node->op);
       __builtin_unreachable();
   }
 }
 
+// Generate the code for the left and right sub-trees of a node, in that
+// order, and then for the node's own operation
+static int genexpr(struct genframe *f, int reg) {
+  int n = f->n;
+
+  // Get left and right sub-tree values
+  if (f->step == 0) {
+    f->step = 1;
+    if (ASTLEFT(n)) {
+      genpush(ASTLEFT(n), NOLABEL, ASTNODE(n)->op);
+      return NOREG;
+    }
+  }
+
+  if (f->step == 1) {
+    f->step = 2;
+    f->leftreg = reg;
+    if (ASTRIGHT(n)) {
+      genpush(ASTRIGHT(n), NOLABEL, ASTNODE(n)->op);
+      return NOREG;
+    }
+  }
+
+  return genpop(genop(n, f->leftreg, reg, f->label, f->parentASTop));
+}
+
+// Given an AST node, the register (if any) holding the previous rvalue, and the
+// AST op of the parent, generate assembly code for the whole tree. Return the
+// register with the final tree value.
+int genAST(int n, int label, int parentASTop) {
+  struct genframe *f;
+  int base = Gendepth;
+  int reg = NOREG;
+
+  genpush(n, label, parentASTop);
+
+  // Step the innermost node along, handing it the value of the child
+  // that was generated last
+  while (Gendepth > base) {
+    f = &Genstack[Gendepth - 1];
+
+    switch (ASTNODE(f->n)->op) {
+      case A_IF:
+        reg = genIF(f, reg);
+        break;
+      case A_WHILE:
+        reg = genWHILE(f, reg);
+        break;
+      case A_FUNCCALL:
+        reg = gen_funccall(f, reg);
+        break;
+      case A_GLUE:
+        reg = genGLUE(f, reg);
+        break;
+      case A_FUNCTION:
+        reg = genFUNCTION(f, reg);
+        break;
+      default:
+        reg = genexpr(f, reg);
+    }
+  }
+
+  return reg;
+}
+
 void genpreamble(void) { cgpreamble(); }
 
-void genpostamble(void) { cgpostamble(); }
+void genpostamble(void) {
+  genstrpool();
+  cgpostamble();
+}
+
+// Called with the real output after each function is added to it
+void genflush(struct output *o) { cgflush(o); }
 
 void genfreeregs(void) { freeall_registers(); }
 
-void genglobalsym(int id) { cgglobalsym(id); }
+// Release this thread's `Genstack[]`
+void freegenstack(void) {
+  free(Genstack);
+  Genstack = NULL;
+  Gendepth = Gencap = 0;
+}
+
+// With `-A`, global symbols and strings are recorded in the AST file instead
+void genglobalsym(int id) {
+  if (O_saveAST)
+    saveglobalsym(id);
+  else
+    cgglobalsym(id);
+}
 
-int genglobalstr(char *strvalue) {
-  int l = genlabel();
-  cgglobalstr(l, strvalue);
-  return l;
+// A string literal's label is its interned name id, `id`. The literals are
+// pooled, and output by `genpostamble()`.
+int genglobalstr(int id, char *strvalue) {
+  if (O_saveAST)
+    savestrlit(id, strvalue);
+  else
+    poolstr(id, strvalue);
+  return id;
 }
 
 int genprimsize(int type) { return cgprimsize(type); }
@@ -5,7 +5,7 @@
 // Code generator for ARMv6 on Raspberry Pi
 
 // List of available registers and their names
-static int freereg[4];
+static _Thread_local int freereg[4];
 static char *reglist[4] = {"r4", "r5", "r6", "r7"};
 
 // Set all registers as available
@@ -35,8 +35,8 @@ static void free_register(int reg) {
 // Keep a list of them that will be output in the postamble.
 #define MAXINTS 1024
 
-int Intlist[MAXINTS];
-static int Intslot = 0;
+_Thread_local int Intlist[MAXINTS];
+static _Thread_local int Intslot = 0;
 
 // Determine the offset of a large integer literal from the `.L3` label.
 // If integer isn't in the list, add it.
@@ -60,54 +60,63 @@ static void set_int_offset(int val) {
   }
 
   // Load `r3` with this offset (address of integer)
-  fprintf(Outfile, "\tldr\tr3, .L3+%d\n", offset);
+  emitf("\tldr\tr3, .L3+%d\n", offset);
 }
 
 // Print out the assembly preamble
-void cgpreamble(void) {
-  freeall_registers();
-  fputs("\t.text\n", Outfile);
+void cgpreamble(void) { freeall_registers(); }
+
+// The directive which starts each section, in `SEC_XXX` order
+static char *sectionlist[] = {"\t.text\n", "\t.data\n", "\t.section\t.rodata\n", "\t.bss\n"};
+
+// With `-pipe`, write out the code in `o` so far
+void cgflush(struct output *o) {
+  if (O_pipe)
+    flushsection(o, SEC_TEXT, sectionlist[SEC_TEXT]);
 }
 
-// Print out the assembly postamble
+// Print out the assembly postamble, then write out the sections
 void cgpostamble() {
+  if (O_object || O_run)
+    fatal("Object file output and `-run` are only for x86-64");
+  emitsection(SEC_TEXT);
+
   // Print out the global variables
-  fprintf(Outfile, ".L2:\n");
+  emitf(".L2:\n");
   for (int i = 0; i < Globals; i++) {
-    if (Symtable[i].stype == S_VARIABLE)
-      fprintf(Outfile, "\t.word %s\n", Symtable[i].name);
+    if (SYMBOL(i)->stype == S_VARIABLE)
+      emitf("\t.word %s\n", SYMBOL(i)->name);
   }
 
   // Print out the integer literals
-  fprintf(Outfile, ".L3:\n");
+  emitf(".L3:\n");
   for (int i = 0; i < Intslot; i++) {
-    fprintf(Outfile, "\t.word %d\n", Intlist[i]);
+    emitf("\t.word %d\n", Intlist[i]);
   }
+
+  writeoutput(Output, sectionlist);
 }
 
 // Print out a function preamble
 void cgfuncpreamble(int id) {
-  char *name = Symtable[id].name;
-  fprintf(Outfile,
-          "\t.text\n"
-          "\t.globl\t%s\n"
-          "\t.type\t%s, \%%function\n"
-          "%s:\n"
-          "\tpush\t{fp, lr}\n"
-          "\tadd\tfp, sp, #4\n"
-          "\tsub\tsp, sp, #8\n"
-          "\tstr\tr0, [fp, #-8]\n",
-          name, name, name);
+  char *name = SYMBOL(id)->name;
+  emitsection(SEC_TEXT);
+  emitf("\t.globl\t%s\n"
+        "\t.type\t%s, \%%function\n"
+        "%s:\n"
+        "\tpush\t{fp, lr}\n"
+        "\tadd\tfp, sp, #4\n"
+        "\tsub\tsp, sp, #8\n"
+        "\tstr\tr0, [fp, #-8]\n",
+        name, name, name);
 }
 
 // Print out a function postamble
 void cgfuncpostamble(int id) {
-  cglabel(Symtable[id].endlabel);
-  fputs(
-      "\tsub\tsp, fp, #4\n"
-      "\tpop\t{fp, pc}\n"
-      "\t.align\t2\n",
-      Outfile);
+  cglabel(SYMBOL(id)->endlabel);
+  EMIT("\tsub\tsp, fp, #4\n"
+       "\tpop\t{fp, pc}\n"
+       "\t.align\t2\n");
 }
 
 // Load an integer literal value into a register, returning its number
@@ -116,10 +125,10 @@ int cgloadint(int value, int type) {
 
   // If the literal value is small, do it with 1 instruction
   if (value <= 1000)
-    fprintf(Outfile, "\tmov\t%s, #%d\n", reglist[r], value);
+    emitf("\tmov\t%s, #%d\n", reglist[r], value);
   else {
     set_int_offset(value);
-    fprintf(Outfile, "\tldr\t%s, [r3]\n", reglist[r]);
+    emitf("\tldr\t%s, [r3]\n", reglist[r]);
   }
 
   return r;
@@ -130,24 +139,24 @@ static void set_var_offset(int id) {
   int offset = 0;
 
   for (int i = 0; i < id; i++) {
-    if (Symtable[i].stype == S_VARIABLE)
+    if (SYMBOL(i)->stype == S_VARIABLE)
       offset += 4;
   }
 
-  fprintf(Outfile, "\tldr\tr3, .L2+%d\n", offset);  // Load `r3` with the offset
+  emitf("\tldr\tr3, .L2+%d\n", offset);  // Load `r3` with the offset
 }
 
 // Load a value from a variable into a register and return its number
 int cgloadglobal(int id) {
   int r = alloc_register();
   set_var_offset(id);
-  fprintf(Outfile, "\tldr\t%s, [r3]\n", reglist[r]);
+  emitf("\tldr\t%s, [r3]\n", reglist[r]);
   return r;
 }
 
 // Add 2 registers and return the register with the result
 int cgadd(int r1, int r2) {
-  fprintf(Outfile, "\tadd\t%s, %s, %s\n", reglist[r2], reglist[r1],
+  emitf("\tadd\t%s, %s, %s\n", reglist[r2], reglist[r1],
           reglist[r2]);
   free_register(r1);
   return r2;
@@ -155,7 +164,7 @@ int cgadd(int r1, int r2) {
 
 // Subtract the 2nd register from the 1st and return the register with the result
 int cgsub(int r1, int r2) {
-  fprintf(Outfile, "\tsub\t%s, %s, %s\n", reglist[r1], reglist[r1],
+  emitf("\tsub\t%s, %s, %s\n", reglist[r1], reglist[r1],
           reglist[r2]);
   free_register(r2);
   return r1;
@@ -163,7 +172,7 @@ int cgsub(int r1, int r2) {
 
 // Multiply 2 registers and return the register with the result
 int cgmul(int r1, int r2) {
-  fprintf(Outfile, "\tmul\t%s, %s, %s\n", reglist[r2], reglist[r1],
+  emitf("\tmul\t%s, %s, %s\n", reglist[r2], reglist[r1],
           reglist[r2]);
   free_register(r1);
   return r2;
@@ -172,25 +181,25 @@ int cgmul(int r1, int r2) {
 // Divide the 1st register by the 2nd and return the register with the result
 int cgdiv(int r1, int r2) {
   // `r0` holds the dividend, `r1` holds the divisor. The quotient will be in `r0`.
-  fprintf(Outfile, "\tmov\tr0, %s\n", reglist[r1]);
-  fprintf(Outfile, "\tmov\tr1, %s\n", reglist[r2]);
-  fprintf(Outfile, "\tbl\t__aeabi_idiv\n");
-  fprintf(Outfile, "\tmov\t%s, r0\n", reglist[r1]);
+  emitf("\tmov\tr0, %s\n", reglist[r1]);
+  emitf("\tmov\tr1, %s\n", reglist[r2]);
+  emitf("\tbl\t__aeabi_idiv\n");
+  emitf("\tmov\t%s, r0\n", reglist[r1]);
   free_register(r2);
   return r1;
 }
 
 // Call a function with 1 argument from the given register; return register with result
 int cgcall(int r, int id) {
-  fprintf(Outfile, "\tmov\tr0, %s\n", reglist[r]);
-  fprintf(Outfile, "\tbl\t%s\n", Symtable[id].name);
-  fprintf(Outfile, "\tmov\t%s, r0\n", reglist[r]);
+  emitf("\tmov\tr0, %s\n", reglist[r]);
+  emitf("\tbl\t%s\n", SYMBOL(id)->name);
+  emitf("\tmov\t%s, r0\n", reglist[r]);
   return r;
 }
 
 // Shift a register left by a constant
 int cgshlconst(int r, int val) {
-  fprintf(Outfile, "\tlsl\t%s, %s, #%d\n", reglist[r], reglist[r], val);
+  emitf("\tlsl\t%s, %s, #%d\n", reglist[r], reglist[r], val);
   return r;
 }
 
@@ -198,16 +207,16 @@ int cgshlconst(int r, int val) {
 int cgstoreglobal(int r, int id) {
   set_var_offset(id);
 
-  switch (Symtable[id].type) {
+  switch (SYMBOL(id)->type) {
     case P_CHAR:
-      fprintf(Outfile, "\tstrb\t%s, [r3]\n", reglist[r]);
+      emitf("\tstrb\t%s, [r3]\n", reglist[r]);
       break;
     case P_INT:
     case P_LONG:
-      fprintf(Outfile, "\tstr\t%s, [r3]\n", reglist[r]);
+      emitf("\tstr\t%s, [r3]\n", reglist[r]);
       break;
     default:
-      fatald("Bad type in `cgstoreglobal()`", Symtable[id].type);
+      fatald("Bad type in `cgstoreglobal()`", SYMBOL(id)->type);
   }
 
   return r;
@@ -226,23 +235,20 @@ int cgprimsize(int type) {
 
 // Generate a global symbol
 void cgglobalsym(int id) {
-  int typesize = cgprimsize(Symtable[id].type);
-
-  fprintf(Outfile,
-          "\t.data\n"
-          "\t.globl\t%s\n",
-          Symtable[id].name);
-
-  switch (typesize) {
-    case 1:
-      fprintf(Outfile, "%s:\t.byte\t0\n", Symtable[id].name);
-      break;
-    case 4:
-      fprintf(Outfile, "%s:\t.long\t0\n", Symtable[id].name);
-      break;
-    default:
-      fatald("Unknown typesize in cgglobalsym: ", typesize);
-  }
+  int typesize = cgprimsize(SYMBOL(id)->type);
+
+  if (typesize != 1 && typesize != 4)
+    fatald("Unknown typesize in cgglobalsym: ", typesize);
+
+  // Globals are all zero to start with, so they go in `.bss`
+  emitsection(SEC_BSS);
+  emitf("\t.globl\t%s\n"
+        "\t.align\t%d\n"
+        "\t.type\t%s, %%object\n"
+        "\t.size\t%s, %d\n"
+        "%s:\t.zero\t%d\n",
+        SYMBOL(id)->name, typesize == 4 ? 2 : 0, SYMBOL(id)->name,
+        SYMBOL(id)->name, typesize, SYMBOL(id)->name, typesize);
 }
 
 // Comparison instructions in AST order: A_EQ, A_NE, A_LT, A_GT, A_LE, A_GE
@@ -256,23 +262,23 @@ int cgcompare_and_set(int ASTop, int r1, int r2) {
   if (ASTop < A_EQ || ASTop > A_GE)
     fatal("Bad ASTop in `cgcompare_and_set()`");
 
-  fprintf(Outfile, "\tcmp\t%s, %s\n", reglist[r1], reglist[r2]);
-  fprintf(Outfile, "\t%s\t%s, #1\n", cmplist[ASTop - A_EQ], reglist[r2]);
-  fprintf(Outfile, "\t%s\t%s, #0\n", invcmplist[ASTop - A_EQ], reglist[r2]);
+  emitf("\tcmp\t%s, %s\n", reglist[r1], reglist[r2]);
+  emitf("\t%s\t%s, #1\n", cmplist[ASTop - A_EQ], reglist[r2]);
+  emitf("\t%s\t%s, #0\n", invcmplist[ASTop - A_EQ], reglist[r2]);
   // Unsigned extend byte: zero-extend a byte to a 32-bit word (1: destination, 2: source)
-  fprintf(Outfile, "\tuxtb\t%s, %s\n", reglist[r2], reglist[r2]);
+  emitf("\tuxtb\t%s, %s\n", reglist[r2], reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 // Generate a label
 void cglabel(int l) {
-  fprintf(Outfile, "L%d:\n", l);
+  emitf("L%d:\n", l);
 }
 
 // Generate a jump to a label
 void cgjump(int l) {
-  fprintf(Outfile, "\tb\tL%d\n", l);
+  emitf("\tb\tL%d\n", l);
 }
 
 // List of inverted branch instructions in AST order: A_EQ, A_NE, A_LT, A_GT, A_LE, A_GE
@@ -283,8 +289,8 @@ int cgcompare_and_jump(int ASTop, int r1, int r2, int label) {
   if (ASTop < A_EQ || ASTop > A_GE)
     fatal("Bad ASTop in `cgcompare_and_set()`");
 
-  fprintf(Outfile, "\tcmp\t%s, %s\n", reglist[r1], reglist[r2]);
-  fprintf(Outfile, "\t%s\tL%d\n", brlist[ASTop - A_EQ], label);
+  emitf("\tcmp\t%s, %s\n", reglist[r1], reglist[r2]);
+  emitf("\t%s\tL%d\n", brlist[ASTop - A_EQ], label);
   freeall_registers();
   return NOREG;
 }
@@ -296,8 +302,8 @@ int cgwiden(int r, int oldtype, int newtype) {
 
 // Generate code to return a value from a function
 void cgreturn(int reg, int id) {
-  fprintf(Outfile, "\tmov\tr0, %s\n", reglist[reg]);
-  cgjump(Symtable[id].endlabel);
+  emitf("\tmov\tr0, %s\n", reglist[reg]);
+  cgjump(SYMBOL(id)->endlabel);
 }
 
 // Generate code to load the address of a global identifier into
@@ -306,7 +312,7 @@ int cgaddress(int id) {
   int r = alloc_register;
 
   set_var_offset(id);  // Get the offset to the variable
-  fprintf(Outfile, "\tmov\t%s, r3\n", reglist[r]);
+  emitf("\tmov\t%s, r3\n", reglist[r]);
   return r;
 }
 
@@ -314,11 +320,11 @@ int cgaddress(int id) {
 int cgderef(int r, int type) {
   switch (type) {
     case P_CHARPTR:
-      fprintf(Outfile, "\tldrb\t%s, [%s]\n", reglist[r], reglist[r]);
+      emitf("\tldrb\t%s, [%s]\n", reglist[r], reglist[r]);
       break;
     case P_INTPTR:
     case P_LONGPTR:
-      fprintf(Outfile, "\tldr\t%s, [%s]\n", reglist[r], reglist[r]);
+      emitf("\tldr\t%s, [%s]\n", reglist[r], reglist[r]);
       break;
   }
 
@@ -329,11 +335,11 @@ int cgderef(int r, int type) {
 int cgstorederef(int r1, int r2, int type) {
   switch (type) {
     case P_CHAR:
-      fprintf(Outfile, "\tstrb\t%s, [%s]\n", reglist[r1], reglist[r2]);
+      emitf("\tstrb\t%s, [%s]\n", reglist[r1], reglist[r2]);
       break;
     case P_INT:
     case P_LONG:
-      fprintf(Outfile, "\tstr\t%s, [%s]\n", reglist[r1], reglist[r2]);
+      emitf("\tstr\t%s, [%s]\n", reglist[r1], reglist[r2]);
       break;
     default:
       fatald("Can't cgstoderef on type:", type);
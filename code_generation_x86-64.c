@@ -9,31 +9,16 @@
 // l: Long (32 bits)
 // q: Quadword (64 bits)
 
-// Flag to specify the section being output to
-enum {
-  no_seg,
-  text_seg,
-  data_seg
-} currSeg = no_seg;
-
-void cgtextseg() {
-  if (currSeg != text_seg) {
-    fputs("\t.text\n", Outfile);
-    currSeg = text_seg;
-  }
-}
-
-void cgdataseg() {
-  if (currSeg != data_seg) {
-    fputs("\t.data\n", Outfile);
-    currSeg = data_seg;
-  }
-}
+// Output goes through the routines in `emit.c`. Register names have their
+// lengths worked out in advance, and string literals are output with
+// `EMIT()`, so nothing here has to parse a format string.
 
 // Position of next local variable relative to the stack base pointer.
 // We store the offset as positive to make aligning the stack pointer easier.
-static int localOffset;
-static int stackOffset;
+// Like the rest of the state here, each code generation thread has its own
+// (see `jobs.c`).
+static _Thread_local int localOffset;
+static _Thread_local int stackOffset;
 
 // Create the position of a new local variable
 static int newlocaloffset(int type) {
@@ -47,13 +32,70 @@ static int newlocaloffset(int type) {
 // The list also includes the registers used to hold function parameters.
 #define NUMFREEREGS 4
 #define FIRSTPARAMREG 9  // Position of first parameter register
-static int freereg[NUMFREEREGS];
-static char *reglist[] =
-    {"%r10", "%r11", "%r12", "%r13", "%r9", "%r8", "%rcx", "%rdx", "%rsi", "%rdi"};
-static char *breglist[] =
-    {"%r10b", "%r11b", "%r12b", "%r13b", "%r9b", "%r8b", "%cl", "%dl", "%sil", "%dil"};
-static char *dreglist[] =
-    {"%r10d", "%r11d", "%r12d", "%r13d", "%r9d", "%r8d", "%ecx", "%edx", "%esi", "%edi"};
+static _Thread_local int freereg[NUMFREEREGS];
+struct regname {
+  char *name;
+  int len;
+};
+#define REG(name) {name, sizeof(name) - 1}
+static struct regname reglist[] = {
+    REG("%r10"), REG("%r11"), REG("%r12"), REG("%r13"), REG("%r9"),
+    REG("%r8"), REG("%rcx"), REG("%rdx"), REG("%rsi"), REG("%rdi")};
+static struct regname breglist[] = {
+    REG("%r10b"), REG("%r11b"), REG("%r12b"), REG("%r13b"), REG("%r9b"),
+    REG("%r8b"), REG("%cl"), REG("%dl"), REG("%sil"), REG("%dil")};
+static struct regname dreglist[] = {
+    REG("%r10d"), REG("%r11d"), REG("%r12d"), REG("%r13d"), REG("%r9d"),
+    REG("%r8d"), REG("%ecx"), REG("%edx"), REG("%esi"), REG("%edi")};
+
+// Output a register's name, from one of the lists above
+static void emitreg(struct regname *r) { emitn(r->name, r->len); }
+
+// Output an instruction with one register operand
+static void insr(char *op, struct regname *r) {
+  emits(op);
+  emitreg(r);
+  EMIT("\n");
+}
+
+// Output an instruction with a source and a destination register.
+// `op` is the mnemonic with the tabs around it.
+static void insrr(char *op, struct regname *src, struct regname *dst) {
+  emits(op);
+  emitreg(src);
+  EMIT(", ");
+  emitreg(dst);
+  EMIT("\n");
+}
+
+// Output label `l` of the current function. Labels are numbered afresh in
+// each function, so a label's name includes the name of the function it
+// belongs to: `.L<function>.<number>`.
+static void emitlabel(int l) {
+  EMIT(".L");
+  emits(SYMBOL(Functionid)->name);
+  emitc('.');
+  emitd(l);
+}
+
+// Output the memory operand of a global variable, relative to `%rip`
+static void globalvar(int id) {
+  emits(SYMBOL(id)->name);
+  EMIT("(%rip)");
+}
+
+// Output the memory operand of a local variable, relative to `%rbp`
+static void localvar(int id) {
+  emitd(SYMBOL(id)->position);
+  EMIT("(%rbp)");
+}
+
+// Output an instruction whose one operand is a variable, given by `var()`
+static void insvar(char *op, void (*var)(int), int id) {
+  emits(op);
+  var(id);
+  EMIT("\n");
+}
 
 // Set all registers as available
 void freeall_registers(void) {
@@ -84,8 +126,6 @@ static void free_register(int reg) {
 // Print out the assembly preamble
 void cgpreamble(void) {
   freeall_registers();
-  fputs("\textern\tprintint\n", Outfile);
-  fputs("\textern\tprintchar\n", Outfile);
 
   /*
   |        Higher Addresses        |
@@ -128,214 +168,213 @@ void cgpreamble(void) {
   // Outfile);
 }
 
-// Nothing to do
-void cgpostamble() {}
+// The directive which starts each section, in `SEC_XXX` order
+static char *sectionlist[] = {"\t.text\n", "\t.data\n", "\t.section\t.rodata\n", "\t.bss\n"};
+
+// With `-pipe`, write out the code in `o` so far
+void cgflush(struct output *o) {
+  if (O_pipe)
+    flushsection(o, SEC_TEXT, sectionlist[SEC_TEXT]);
+}
+
+// Write out the sections, as assembly or with `-c` as an object file. With
+// `-run` they are kept for `runobject()`.
+void cgpostamble() {
+  if (O_run)
+    return;
+  if (O_object)
+    writeobject();
+  else
+    writeoutput(Output, sectionlist);
+}
+
+// Return the stack offset just below the newest local before local `i` that
+// is still in scope when `i` is declared. Locals of scopes which have ended
+// are stepped over a whole scope at a time.
+static int liveoffset(int i) {
+  struct symtable *sym;
+
+  for (int j = i - 1; j >= 0; j--) {
+    sym = &Localsyms[j];
+    if (sym->scopeend <= i)
+      j = sym->scopestart;
+    else if (sym->position < 0)
+      return -sym->position;
+  }
+
+  return 0;
+}
 
 // Print out a function preamble
 void cgfuncpreamble(int id) {
-  char *name = Symtable[id].name;
-  int i;
+  char *name = SYMBOL(id)->name;
+  struct symtable *sym;
+  int i, maxOffset;
   int paramOffset = 16;          // Any pushed parameters start at this stack offset
   int paramReg = FIRSTPARAMREG;  // Index to the first parameter register in above reg lists
 
-  cgtextseg();
+  emitsection(SEC_TEXT);
   localOffset = 0;
 
-  fprintf(Outfile,
-          "\t.globl\t%s\n"
-          "\t.type\t%s, @function\n"
-          "%s:\n"
-          "\tpushq\t%%rbp\n"
-          "\tmovq\t%%rsp, %%rbp\n",
-          name, name, name);
+  EMIT("\t.globl\t");
+  emits(name);
+  EMIT("\n\t.type\t");
+  emits(name);
+  EMIT(", @function\n");
+  emits(name);
+  EMIT(":\n"
+       "\tpushq\t%rbp\n"
+       "\tmovq\t%rsp, %rbp\n");
 
   // Copy any in-register parameters to the stack.
   // Stop after no more than six parameter registers.
-  for (i = NSYMBOLS - 1; i > Locals; i--) {
-    if (Symtable[i].class != C_PARAM)
+  for (i = 0; i < Locals; i++) {
+    sym = &Localsyms[i];
+    if (sym->class != C_PARAM)
       break;
-    if (i < NSYMBOLS - 6)
+    if (i >= 6)
       break;
-    Symtable[i].position = newlocaloffset(Symtable[i].type);
-    cgstorlocal(paramReg--, i);
+    sym->position = newlocaloffset(sym->type);
+    cgstorlocal(paramReg--, LOCALSYM | i);
   }
 
   // For the remainder, if they are a parameter then they are already on the stack.
-  // If only a local, make a stack position.
-  for (; i > Locals; i--) {
-    if (Symtable[i].class == C_PARAM) {
-      Symtable[i].position = paramOffset;
+  // If only a local, make a stack position. Locals whose scopes don't overlap
+  // share the same stack space.
+  maxOffset = localOffset;
+  for (; i < Locals; i++) {
+    sym = &Localsyms[i];
+    if (sym->class == C_PARAM) {
+      sym->position = paramOffset;
       paramOffset += 8;
     } else {
-      Symtable[i].position = newlocaloffset(Symtable[i].type);
+      localOffset = liveoffset(i);
+      sym->position = newlocaloffset(sym->type);
+      if (localOffset > maxOffset)
+        maxOffset = localOffset;
     }
   }
 
   // Align the stack pointer to be a multiple of 16
   // less than its previous value
-  stackOffset = (localOffset + 15) & ~15;
-  fprintf(Outfile, "\taddq\t$%d,%%rsp\n", -stackOffset);
+  stackOffset = (maxOffset + 15) & ~15;
+  EMIT("\taddq\t$");
+  emitd(-stackOffset);
+  EMIT(",%rsp\n");
 }
 
 // Print out a function postamble
 void cgfuncpostamble(int id) {
-  cglabel(Symtable[id].endlabel);
-  fprintf(Outfile, "\taddq\t$%d,%%rsp\n", stackOffset);
-  fputs(
-      "\tpopq	%rbp\n"
-      "\tret\n",
-      Outfile);
+  cglabel(SYMBOL(id)->endlabel);
+  EMIT("\taddq\t$");
+  emitd(stackOffset);
+  EMIT(",%rsp\n"
+       "\tpopq	%rbp\n"
+       "\tret\n");
 }
 
 // Load an integer literal value into a register and return the register number.
 // For x86-64, we don't need to worry about the type.
 int cgloadint(int value, int type) {
   int r = alloc_register();
-  fprintf(Outfile, "\tmovq\t$%d, %s\n", value, reglist[r]);
+  EMIT("\tmovq\t$");
+  emitd(value);
+  EMIT(", ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
   return r;
 }
 
-// Load a value from a global variable into a register and return the number of the register.
-// If the operation is pre- or post-increment/decrement, also perform this action.
-int cgloadglobal(int id, int op) {
+// Load variable `id`, whose operand is given by `var()`, into a new register
+// and return the number of the register. If the operation is pre- or
+// post-increment/decrement, also perform this action. `err` is the message
+// for a bad type.
+static int loadvar(int id, int op, void (*var)(int), char *err) {
   int r = alloc_register();
+  char *inc, *dec, *load;
 
-  switch (Symtable[id].type) {
+  switch (SYMBOL(id)->type) {
     case P_CHAR:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincb\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecb\t%s(%%rip)\n", Symtable[id].name);
-
-      fprintf(Outfile, "\tmovzbq\t%s(%%rip), %s\n", Symtable[id].name, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincb\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecb\t%s(%%rip)\n", Symtable[id].name);
+      inc = "\tincb\t";
+      dec = "\tdecb\t";
+      load = "\tmovzbq\t";
       break;
-
     case P_INT:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincl\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecl\t%s(%%rip)\n", Symtable[id].name);
-
-      fprintf(Outfile, "\tmovslq\t%s(%%rip), %s\n", Symtable[id].name, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincl\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecl\t%s(%%rip)\n", Symtable[id].name);
+      inc = "\tincl\t";
+      dec = "\tdecl\t";
+      load = "\tmovslq\t";
       break;
-
     case P_LONG:
     case P_CHARPTR:
     case P_INTPTR:
     case P_LONGPTR:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincq\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecq\t%s(%%rip)\n", Symtable[id].name);
-
-      fprintf(Outfile, "\tmovq\t%s(%%rip), %s\n", Symtable[id].name, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincq\t%s(%%rip)\n", Symtable[id].name);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecq\t%s(%%rip)\n", Symtable[id].name);
+      inc = "\tincq\t";
+      dec = "\tdecq\t";
+      load = "\tmovq\t";
       break;
-
     default:
-      fatald("Bad type in `cgloadglobal()`:", Symtable[id].type);
+      fatald(err, SYMBOL(id)->type);
   }
 
+  if (op == A_PREINC)
+    insvar(inc, var, id);
+  if (op == A_PREDEC)
+    insvar(dec, var, id);
+
+  emits(load);
+  var(id);
+  EMIT(", ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
+
+  if (op == A_POSTINC)
+    insvar(inc, var, id);
+  if (op == A_POSTDEC)
+    insvar(dec, var, id);
+
   return r;
 }
 
+// Load a value from a global variable into a register and return the number of the register.
+// If the operation is pre- or post-increment/decrement, also perform this action.
+int cgloadglobal(int id, int op) {
+  return loadvar(id, op, globalvar, "Bad type in `cgloadglobal()`:");
+}
+
 // Load a value from a local variable into a register and return the number of the register.
 // If the operation is pre- or post-increment/decrement, also perform this action.
 int cgloadlocal(int id, int op) {
-  int r = alloc_register();
-
-  switch (Symtable[id].type) {
-    case P_CHAR:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincb\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecb\t%d(%%rbp)\n", Symtable[id].position);
-
-      fprintf(Outfile, "\tmovzbq\t%d(%%rbp), %s\n", Symtable[id].position, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincb\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecb\t%d(%%rbp)\n", Symtable[id].position);
-      break;
-
-    case P_INT:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincl\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecl\t%d(%%rbp)\n", Symtable[id].position);
-
-      fprintf(Outfile, "\tmovslq\t%d(%%rbp), %s\n", Symtable[id].position, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincl\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecl\t%d(%%rbp)\n", Symtable[id].position);
-      break;
-
-    case P_LONG:
-    case P_CHARPTR:
-    case P_INTPTR:
-    case P_LONGPTR:
-      if (op == A_PREINC)
-        fprintf(Outfile, "\tincq\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_PREDEC)
-        fprintf(Outfile, "\tdecq\t%d(%%rbp)\n", Symtable[id].position);
-
-      fprintf(Outfile, "\tmovq\t%d(%%rbp), %s\n", Symtable[id].position, reglist[r]);
-
-      if (op == A_POSTINC)
-        fprintf(Outfile, "\tincq\t%d(%%rbp)\n", Symtable[id].position);
-      if (op == A_POSTDEC)
-        fprintf(Outfile, "\tdecq\t%d(%%rbp)\n", Symtable[id].position);
-      break;
-
-    default:
-      fatald("Bad type in `cgloadlocal()`:", Symtable[id].type);
-  }
-
-  return r;
+  return loadvar(id, op, localvar, "Bad type in `cgloadlocal()`:");
 }
 
 // Given the label number of a global string, load its address into a new register
 int cgloadglobalstr(int id) {
   int r = alloc_register();
-  fprintf(Outfile, "\tleaq\tL%d(%%rip), %s\n", id, reglist[r]);
+  EMIT("\tleaq\t.LS");
+  emitd(id);
+  EMIT("(%rip), ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
   return r;
 }
 
 // Add 2 registers and return the number of the register with the result
 int cgadd(int r1, int r2) {
-  fprintf(Outfile, "\taddq\t%s, %s\n", reglist[r1], reglist[r2]);
+  insrr("\taddq\t", &reglist[r1], &reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 // Subtract the second register from the first
 int cgsub(int r1, int r2) {
-  fprintf(Outfile, "\tsubq\t%s, %s\n", reglist[r2],
-          reglist[r1]);  // source, destination ... (d - s) -> d
+  insrr("\tsubq\t", &reglist[r2], &reglist[r1]);  // source, destination ... (d - s) -> d
   free_register(r2);
   return r1;
 }
 
 // Multiply 2 registers and return the number of the register with the result
 int cgmul(int r1, int r2) {
-  fprintf(Outfile, "\timulq\t%s, %s\n", reglist[r1], reglist[r2]);
+  insrr("\timulq\t", &reglist[r1], &reglist[r2]);
   free_register(r1);
   return r2;
 }
@@ -343,78 +382,87 @@ int cgmul(int r1, int r2) {
 // Divide the first register by the sceond and return the number of the register
 // with the result
 int cgdiv(int r1, int r2) {
-  fprintf(Outfile, "\tmovq\t%s,%%rax\n", reglist[r1]);
-  fprintf(Outfile, "\tcqo\n");  // Extend %rax to 8 bytes
-  fprintf(Outfile, "\tidivq\t%s\n",
-          reglist[r2]);  // (%rax / r2) -> quotient in %rax, remainder in %rdx
-  fprintf(Outfile, "\tmovq\t%%rax,%s\n", reglist[r1]);
+  EMIT("\tmovq\t");
+  emitreg(&reglist[r1]);
+  EMIT(",%rax\n");
+  EMIT("\tcqo\n");                      // Extend %rax to 8 bytes
+  insr("\tidivq\t", &reglist[r2]);  // (%rax / r2) -> quotient in %rax, remainder in %rdx
+  EMIT("\tmovq\t%rax,");
+  emitreg(&reglist[r1]);
+  EMIT("\n");
   free_register(r2);
   return r1;
 }
 
 int cgand(int r1, int r2) {
-  fprintf(Outfile, "\tandq\t%s, %s\n", reglist[r1], reglist[r2]);
+  insrr("\tandq\t", &reglist[r1], &reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 int cgor(int r1, int r2) {
-  fprintf(Outfile, "\torq\t%s, %s\n", reglist[r1], reglist[r2]);
+  insrr("\torq\t", &reglist[r1], &reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 int cgxor(int r1, int r2) {
-  fprintf(Outfile, "\txorq\t%s, %s\n", reglist[r1], reglist[r2]);
+  insrr("\txorq\t", &reglist[r1], &reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 int cgshl(int r1, int r2) {
-  fprintf(Outfile, "\tmovb\t%s, %%cl\n", breglist[r2]);
-  fprintf(Outfile, "\tshlq\t%%cl, %s\n", reglist[r1]);
+  EMIT("\tmovb\t");
+  emitreg(&breglist[r2]);
+  EMIT(", %cl\n");
+  insr("\tshlq\t%cl, ", &reglist[r1]);
   free_register(r2);
   return r1;
 }
 
 int cgshr(int r1, int r2) {
-  fprintf(Outfile, "\tmovb\t%s, %%cl\n", breglist[r2]);
-  fprintf(Outfile, "\tshrq\t%%cl, %s\n", reglist[r1]);
+  EMIT("\tmovb\t");
+  emitreg(&breglist[r2]);
+  EMIT(", %cl\n");
+  insr("\tshrq\t%cl, ", &reglist[r1]);
   free_register(r2);
   return r1;
 }
 
 // Negate a register's value
 int cgnegate(int r) {
-  fprintf(Outfile, "\tnegq\t%s\n", reglist[r]);
+  insr("\tnegq\t", &reglist[r]);
   return r;
 }
 
 // Invert a register's value
 int cginvert(int r) {
-  fprintf(Outfile, "\tnotq\t%s\n", reglist[r]);
+  insr("\tnotq\t", &reglist[r]);
   return r;
 }
 
 // Logically negate a register's value
 int cglognot(int r) {
   // `test` essentially ANDs the register with itself to set the zero and negative flags
-  fprintf(Outfile, "\ttest\t%s, %s\n", reglist[r], reglist[r]);
+  insrr("\ttest\t", &reglist[r], &reglist[r]);
   // Then, set register to 1 if it is equal to zero (`sete`)
-  fprintf(Outfile, "\tsete\t%s\n", breglist[r]);
-  fprintf(Outfile, "\tmovzbq\t%s, %s\n", breglist[r], reglist[r]);  // 8-bit -> 64-bit
+  insr("\tsete\t", &breglist[r]);
+  insrr("\tmovzbq\t", &breglist[r], &reglist[r]);  // 8-bit -> 64-bit
   return r;
 }
 
 // Convert an integer value to a boolean value. Jump if it's an IF or WHILE operation.
 int cgboolean(int r, int op, int label) {
-  fprintf(Outfile, "\ttest\t%s, %s\n", reglist[r], reglist[r]);
+  insrr("\ttest\t", &reglist[r], &reglist[r]);
 
-  if (op == A_IF || op == A_WHILE)
-    fprintf(Outfile, "\tje\tL%d\n", label);  // Jump if result of `test` was false
-  else {
-    fprintf(Outfile, "\tsetnz\t%s\n", breglist[r]);
-    fprintf(Outfile, "\tmovzbq\t%s, %s\n", breglist[r], reglist[r]);
+  if (op == A_IF || op == A_WHILE) {
+    EMIT("\tje\t");  // Jump if result of `test` was false
+    emitlabel(label);
+    EMIT("\n");
+  } else {
+    insr("\tsetnz\t", &breglist[r]);
+    insrr("\tmovzbq\t", &breglist[r], &reglist[r]);
   }
 
   return r;
@@ -425,13 +473,18 @@ int cgboolean(int r, int op, int label) {
 // Return register with result (comes from `%rax`).
 int cgcall(int id, int numargs) {
   int outr = alloc_register();
-  fprintf(Outfile, "\tcall\t%s\n", Symtable[id].name);
+  EMIT("\tcall\t");
+  emits(SYMBOL(id)->name);
+  EMIT("\n");
 
   // Pop off any arguments pushed onto the stack
-  if (numargs > 6)
-    fprintf(Outfile, "\taddq\t$%d, %%rsp\n", 8 * (numargs - 6));
+  if (numargs > 6) {
+    EMIT("\taddq\t$");
+    emitd(8 * (numargs - 6));
+    EMIT(", %rsp\n");
+  }
 
-  fprintf(Outfile, "\tmovq\t%%rax, %s\n", reglist[outr]);
+  insr("\tmovq\t%rax, ", &reglist[outr]);
 
   return outr;
 }
@@ -442,64 +495,60 @@ void cgcopyarg(int r, int argposition) {
   // If > sixth argument, simply push the register onto the stack. We rely on being
   // called with successive arguments in the correct order for x86-64
   if (argposition > 6) {
-    fprintf(Outfile, "\tpushq\t%s\n", reglist[r]);
+    insr("\tpushq\t", &reglist[r]);
   } else {
     // Otherwise, copy the value into one of the 6 registers used to hold parameter values
-    fprintf(
-        Outfile,
-        "\tmovq\t%s, %s\n",
-        reglist[r],
-        reglist[FIRSTPARAMREG - argposition + 1]);
+    insrr("\tmovq\t", &reglist[r], &reglist[FIRSTPARAMREG - argposition + 1]);
   }
 }
 
 // Shift a register left by a constant
 int cgshlconst(int r, int val) {
-  fprintf(Outfile, "\tsalq\t$%d, %s\n", val, reglist[r]);
+  EMIT("\tsalq\t$");
+  emitd(val);
+  EMIT(", ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
   return r;
 }
 
-// Store a register's value into a global variable
-int cgstoreglobal(int r, int id) {
-  switch (Symtable[id].type) {
+// Store a register's value into variable `id`, whose operand is given by
+// `var()`. `err` is the message for a bad type.
+static int storevar(int r, int id, void (*var)(int), char *err) {
+  switch (SYMBOL(id)->type) {
     case P_CHAR:
-      fprintf(Outfile, "\tmovb\t%s, %s(%%rip)\n", breglist[r], Symtable[id].name);
+      EMIT("\tmovb\t");
+      emitreg(&breglist[r]);
       break;
     case P_INT:
-      fprintf(Outfile, "\tmovl\t%s, %s(%%rip)\n", dreglist[r], Symtable[id].name);
+      EMIT("\tmovl\t");
+      emitreg(&dreglist[r]);
       break;
     case P_LONG:
     case P_CHARPTR:
     case P_INTPTR:
     case P_LONGPTR:
-      fprintf(Outfile, "\tmovq\t%s, %s(%%rip)\n", reglist[r], Symtable[id].name);
+      EMIT("\tmovq\t");
+      emitreg(&reglist[r]);
       break;
     default:
-      fatald("Bad type in `cgstoreglobal()`:", Symtable[id].type);
+      fatald(err, SYMBOL(id)->type);
   }
 
+  EMIT(", ");
+  var(id);
+  EMIT("\n");
   return r;
 }
 
+// Store a register's value into a global variable
+int cgstoreglobal(int r, int id) {
+  return storevar(r, id, globalvar, "Bad type in `cgstoreglobal()`:");
+}
+
 // Store a register's value into a local variable
 int cgstorlocal(int r, int id) {
-  switch (Symtable[id].type) {
-    case P_CHAR:
-      fprintf(Outfile, "\tmovb\t%s, %d(%%rbp)\n", breglist[r], Symtable[id].position);
-      break;
-    case P_INT:
-      fprintf(Outfile, "\tmovl\t%s, %d(%%rbp)\n", dreglist[r], Symtable[id].position);
-      break;
-    case P_LONG:
-    case P_CHARPTR:
-    case P_INTPTR:
-    case P_LONGPTR:
-      fprintf(Outfile, "\tmovq\t%s, %d(%%rbp)\n", reglist[r], Symtable[id].position);
-      break;
-    default:
-      fatald("Bad type in cgstorlocal:", Symtable[id].type);
-  }
-  return r;
+  return storevar(r, id, localvar, "Bad type in cgstorlocal:");
 }
 
 // Array of type sizes in P_XXX order (0 means no size)
@@ -522,48 +571,79 @@ int cgprimsize(int type) {
   return psize[type];
 }
 
-// Generate a global symbol, but not functions
+// Generate a global symbol, but not functions. Globals can't be given an
+// initial value, so they all go in the `.bss` section, and one `.zero` makes
+// the space for all of an array's elements.
 void cgglobalsym(int id) {
-  if (Symtable[id].stype == S_FUNCTION)
-    return;
+  struct symtable *sym = SYMBOL(id);
+  int typesize;
+  long size;
 
-  int typesize = cgprimsize(Symtable[id].type);
+  if (sym->stype == S_FUNCTION)
+    return;
 
-  // Generate the global identity and the label
-  cgdataseg();
-  fprintf(Outfile, "\t.globl\t%s\n", Symtable[id].name);
-  fprintf(Outfile, "%s:", Symtable[id].name);
+  typesize = cgprimsize(sym->type);
+  if (typesize == 0)
+    fatald("Unknown typesize in `cgglobalsym()`: ", typesize);
+  size = (long)typesize * sym->size;
+
+  // Generate the global identity, its alignment, type and size, and the label
+  emitsection(SEC_BSS);
+  EMIT("\t.globl\t");
+  emits(sym->name);
+  EMIT("\n\t.align\t");
+  emitd(typesize);
+  EMIT("\n\t.type\t");
+  emits(sym->name);
+  EMIT(", @object\n\t.size\t");
+  emits(sym->name);
+  EMIT(", ");
+  emitd(size);
+  EMIT("\n");
+  emits(sym->name);
 
   // Generate the space
-  for (int i = 0; i < Symtable[id].size; i++) {
-    switch (typesize) {
-      case 1:
-        fprintf(Outfile, "\t.byte\t0\n");
-        break;
-      case 4:
-        fprintf(Outfile, "\t.long\t0\n");
-        break;
-      case 8:
-        fprintf(Outfile, "\t.quad\t0\n");
-        break;
-      default:
-        fatald("Unknown typesize in `cgglobalsym()`: ", typesize);
-    }
-  }
+  EMIT(":\n\t.zero\t");
+  emitd(size);
+  EMIT("\n");
 }
 
-// Generate a global string and its start label
-void cgglobalstr(int l, char *strvalue) {
-  char *cptr;
-  cglabel(l);
-  for (cptr = strvalue; *cptr; cptr++) {
-    fprintf(Outfile, "\t.byte\t%d\n", *cptr);
+// Generate the label of a pooled string literal (see `strpool.c`). These
+// are numbered across the whole program: `.LS<number>`.
+void cgstrlabel(int l) {
+  EMIT(".LS");
+  emitd(l);
+  EMIT(":\n");
+}
+
+// Generate `len` characters of a string literal, NUL-terminated if `end` is
+// set. Characters which can't go in the quotes as they are become octal escapes.
+void cgstrchars(char *s, int len, int end) {
+  unsigned char c;
+
+  if (len == 0 && !end)
+    return;
+
+  if (end)
+    EMIT("\t.string\t\"");
+  else
+    EMIT("\t.ascii\t\"");
+  for (int i = 0; i < len; i++) {
+    c = s[i];
+    if (c >= ' ' && c <= '~' && c != '"' && c != '\\')
+      emitc(c);
+    else {
+      emitc('\\');
+      emitc('0' + (c >> 6));
+      emitc('0' + ((c >> 3) & 7));
+      emitc('0' + (c & 7));
+    }
   }
-  fprintf(Outfile, "\t.byte\t0\n");
+  EMIT("\"\n");
 }
 
 // Comparison instructions in AST order: A_EQ, A_NE, A_LT, A_GT, A_LE, A_GE
-static char *cmplist[] = {"sete", "setne", "setl", "setg", "setle", "setge"};
+static char *cmplist[] = {"\tsete\t", "\tsetne\t", "\tsetl\t", "\tsetg\t", "\tsetle\t", "\tsetge\t"};
 
 // Compare 2 registers and set `r2` if true
 int cgcompare_and_set(int ASTop, int r1, int r2) {
@@ -571,29 +651,38 @@ int cgcompare_and_set(int ASTop, int r1, int r2) {
   if (ASTop < A_EQ || ASTop > A_GE)
     fatal("Bad ASTop in `cgcompare_and_set()`");
 
-  fprintf(Outfile, "\tcmpq\t%s, %s\n", reglist[r2], reglist[r1]);
-  fprintf(Outfile, "\t%s\t%s\n", cmplist[ASTop - A_EQ], breglist[r2]);
-  fprintf(Outfile, "\tmovzbq\t%s, %s\n", breglist[r2], reglist[r2]);
+  insrr("\tcmpq\t", &reglist[r2], &reglist[r1]);
+  insr(cmplist[ASTop - A_EQ], &breglist[r2]);
+  insrr("\tmovzbq\t", &breglist[r2], &reglist[r2]);
   free_register(r1);
   return r2;
 }
 
 // Generate a label
-void cglabel(int l) { fprintf(Outfile, "L%d:\n", l); }
+void cglabel(int l) {
+  emitlabel(l);
+  EMIT(":\n");
+}
 
 // Generate a jump to a label
-void cgjump(int l) { fprintf(Outfile, "\tjmp\tL%d\n", l); }
+void cgjump(int l) {
+  EMIT("\tjmp\t");
+  emitlabel(l);
+  EMIT("\n");
+}
 
 // Inverted jump instructions: A_EQ, A_NE, A_LT, A_GT, A_LE, A_GE
-static char *invcmplist[] = {"jne", "je", "jge", "jle", "jg", "jl"};
+static char *invcmplist[] = {"\tjne\t", "\tje\t", "\tjge\t", "\tjle\t", "\tjg\t", "\tjl\t"};
 
 // Compare 2 registers and jump if FALSE
 int cgcompare_and_jump(int ASTop, int r1, int r2, int label) {
   if (ASTop < A_EQ || ASTop > A_GE)
     fatal("Bad ASTop in `cgcompare_and_jump()`");
 
-  fprintf(Outfile, "\tcmpq\t%s, %s\n", reglist[r2], reglist[r1]);
-  fprintf(Outfile, "\t%s\tL%d\n", invcmplist[ASTop - A_EQ], label);
+  insrr("\tcmpq\t", &reglist[r2], &reglist[r1]);
+  emits(invcmplist[ASTop - A_EQ]);
+  emitlabel(label);
+  EMIT("\n");
   freeall_registers();
   return NOREG;
 }
@@ -605,31 +694,41 @@ int cgwiden(int r, int oldtype, int newtype) {
 
 // Generate code to return a value from a function
 void cgreturn(int reg, int id) {
-  switch (Symtable[id].type) {
+  switch (SYMBOL(id)->type) {
     case P_CHAR:
-      fprintf(Outfile, "\tmovzbl\t%s, %%eax\n", breglist[reg]);
+      EMIT("\tmovzbl\t");
+      emitreg(&breglist[reg]);
+      EMIT(", %eax\n");
       break;
     case P_INT:
-      fprintf(Outfile, "\tmovl\t%s, %%eax\n", dreglist[reg]);
+      EMIT("\tmovl\t");
+      emitreg(&dreglist[reg]);
+      EMIT(", %eax\n");
       break;
     case P_LONG:
-      fprintf(Outfile, "\tmovq\t%s, %%rax\n", reglist[reg]);
+      EMIT("\tmovq\t");
+      emitreg(&reglist[reg]);
+      EMIT(", %rax\n");
       break;
     default:
-      fatald("Bad function type in `cgreturn()`:", Symtable[id].type);
+      fatald("Bad function type in `cgreturn()`:", SYMBOL(id)->type);
   }
 
-  cgjump(Symtable[id].endlabel);
+  cgjump(SYMBOL(id)->endlabel);
 }
 
 // Load the address of a global identifier into a variable. Return a new register.
 int cgaddress(int id) {
   int r = alloc_register();
 
-  if (Symtable[id].class == C_LOCAL)
-    fprintf(Outfile, "\tleaq\t%d(%%rbp), %s\n", Symtable[id].position, reglist[r]);
+  EMIT("\tleaq\t");
+  if (SYMBOL(id)->class == C_LOCAL)
+    localvar(id);
   else
-    fprintf(Outfile, "\tleaq\t%s(%%rip), %s\n", Symtable[id].name, reglist[r]);
+    globalvar(id);
+  EMIT(", ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
 
   return r;
 }
@@ -638,18 +737,23 @@ int cgaddress(int id) {
 int cgderef(int r, int type) {
   switch (type) {
     case P_CHARPTR:
-      fprintf(Outfile, "\tmovzbq\t(%s), %s\n", reglist[r], reglist[r]);
+      EMIT("\tmovzbq\t(");
       break;
     case P_INTPTR:
-      fprintf(Outfile, "\tmovslq\t(%s), %s\n", reglist[r], reglist[r]);
+      EMIT("\tmovslq\t(");
       break;
     case P_LONGPTR:
-      fprintf(Outfile, "\tmovq\t(%s), %s\n", reglist[r], reglist[r]);
+      EMIT("\tmovq\t(");
       break;
     default:
       fatald("Can't `cgderef()` on type:", type);
   }
 
+  emitreg(&reglist[r]);
+  EMIT("), ");
+  emitreg(&reglist[r]);
+  EMIT("\n");
+
   return r;
 }
 
@@ -657,17 +761,21 @@ int cgderef(int r, int type) {
 int cgstorederef(int r1, int r2, int type) {
   switch (type) {
     case P_CHAR:
-      fprintf(Outfile, "\tmovb\t%s, (%s)\n", breglist[r1], reglist[r2]);
+      EMIT("\tmovb\t");
+      emitreg(&breglist[r1]);
       break;
     case P_INT:
-      fprintf(Outfile, "\tmovq\t%s, (%s)\n", reglist[r1], reglist[r2]);
-      break;
     case P_LONG:
-      fprintf(Outfile, "\tmovq\t%s, (%s)\n", reglist[r1], reglist[r2]);
+      EMIT("\tmovq\t");
+      emitreg(&reglist[r1]);
       break;
     default:
       fatald("Can't `cgstoderef()` on type:", type);
   }
 
+  EMIT(", (");
+  emitreg(&reglist[r2]);
+  EMIT(")\n");
+
   return r1;
 }
@@ -0,0 +1,191 @@
+#include "definitions.h"
+
+#define extern_
+#include "data.h"
+#undef extern_
+
+#include "declarations.h"
+#include "compiler.h"
+#include <setjmp.h>
+
+// Compilation contexts, and compiling from memory to memory.
+// The state which the threads of a compilation share is kept in its
+// context, `struct compiler`, and each thread's `Ctx` points to it. The
+// rest is per thread: the parser and code generator only ever work on one
+// function at a time on any thread. `bin/b` has one context, set up by
+// `main()`, and the library in `bin/libcomp.a` has one for each caller
+// (see `compiler.h`).
+//
+// `compilebuffer()` runs each compilation on a new thread, so its per-thread
+// state starts out fresh, and its fatal errors are caught with `Fatalhook`
+// instead of stopping the process. Everything that it allocates is freed at
+// the end but the output. Source is compiled into assembly, or an object
+// file with `object`, on one thread or with worker threads as with `-j`;
+// the options for files, the cache and the lexer thread aren't offered.
+
+// A call to `compilebuffer()`, handed to its thread
+struct request {
+  struct compiler *c;
+  char *src;
+  size_t len;
+  int status;  // 0 on success or -1
+};
+
+static _Thread_local jmp_buf Compileabort;  // Where a compilation goes after a fatal error
+
+// Return a new context to compile with `opts`, or NULL if there's no memory
+struct compiler *newcompiler(struct compileoptions *opts) {
+  struct compiler *c;
+
+  if ((c = calloc(1, sizeof(struct compiler))) == NULL)
+    return NULL;
+
+  // As with `-j`, functions are only done on other threads if there is
+  // more than one
+  if (opts != NULL) {
+    c->object = opts->object;
+    c->jobs = (opts->jobs >= 2) ? opts->jobs : 0;
+    c->pretokenize = opts->pretokenize;
+  }
+
+  pthread_mutex_init(&c->poollock, NULL);
+  pthread_mutex_init(&c->joblock, NULL);
+  pthread_cond_init(&c->jobready, NULL);
+  pthread_cond_init(&c->jobdone, NULL);
+  return c;
+}
+
+// Release a context, along with its output and error message
+void freecompiler(struct compiler *c) {
+  if (c->result != NULL)
+    freeoutbuf(c->result);
+  free(c->error);
+  pthread_mutex_destroy(&c->poollock);
+  pthread_mutex_destroy(&c->joblock);
+  pthread_cond_destroy(&c->jobready);
+  pthread_cond_destroy(&c->jobdone);
+  free(c);
+}
+
+// Return the message of the last compilation's error, or NULL
+char *compilererror(struct compiler *c) {
+  return c->error;
+}
+
+// Declare the functions in `lib/printint.c`, which every program can call
+void addbuiltins(void) {
+  // For now, ensure that `void printint()` is defined
+  addglobal(intern("printint"), P_INT, S_FUNCTION, C_GLOBAL, 0, 0);
+  addglobal(intern("printchar"), P_VOID, S_FUNCTION, C_GLOBAL, 0, 0);
+}
+
+// Compile the source in `Inbuf[]` into `Output`, as set up by the options,
+// then release the input
+void compilesource(void) {
+  // With `-C`, functions in the cache are found by their tokens, and
+  // with `-j` their bodies are parsed from them on other threads
+  if (O_cache)
+    open_cache();
+  if (O_pipeline)
+    start_lexer();  // Scan the input on its own thread
+  else if (O_pretokenize || O_cache || O_jobs)
+    tokenize();  // Turn the whole input into `Tokens[]` up front
+
+  scan(&Token);  // Get the first token from the input
+  if (!O_saveAST)
+    genpreamble();
+  if (O_jobs)
+    start_jobs();  // Functions are handed to worker threads
+  global_declarations();  // Parse the global declarations
+  if (O_jobs)
+    finish_jobs();
+  if (!O_saveAST)
+    genpostamble();
+
+  if (O_pipeline)
+    stop_lexer();
+  free_tokens();
+  close_input();
+}
+
+// Release the buffers which this thread has used for parsing and
+// generating functions
+void freethread(void) {
+  freesymbols();
+  freeASTbuf();
+  freeexprstack();
+  freegenstack();
+}
+
+// A fatal error in `compilebuffer()`: keep the message and abandon the
+// compilation
+static void compilefatal(char *msg) {
+  Ctx->error = msg;
+  longjmp(Compileabort, 1);
+}
+
+// The thread for a call to `compilebuffer()`
+static void *compilethread(void *arg) {
+  struct request *r = arg;
+
+  Ctx = r->c;
+  Line = 1;
+  Fatalhook = compilefatal;
+
+  if (setjmp(Compileabort) == 0) {
+    if ((Inbuf = malloc(r->len + INPUT_PADDING)) == NULL)
+      fatal("Unable to `malloc` in `compilebuffer()`");
+    memcpy(Inbuf, r->src, r->len);
+    memset(Inbuf + r->len, 0, INPUT_PADDING);
+    Inptr = Inbuf;
+    Inend = Inbuf + r->len;
+
+    // `genpostamble()` writes the output to the context's buffer
+    Ctx->result = newoutbuf();
+    useoutput(newoutput(-1));
+    Output->mem = Ctx->result;
+
+    addbuiltins();
+    compilesource();
+    r->status = 0;
+  } else
+    abandon_jobs();
+
+  Fatalhook = NULL;
+  if (Output != NULL)
+    freeoutput(Output);
+  free_tokens();
+  close_input();
+  freestrpool();
+  freeglobalsymbols();
+  freenames();
+  freethread();
+  return NULL;
+}
+
+// Compile the `len` bytes of source at `src` with the context `c`. Return
+// 0 and the output in `*out` and `*outlen`, or -1 after an error.
+int compilebuffer(struct compiler *c, char *src, size_t len, char **out, size_t *outlen) {
+  struct request r = {c, src, len, -1};
+  pthread_t thread;
+
+  if (c->result != NULL)
+    freeoutbuf(c->result);
+  free(c->error);
+  c->result = NULL;
+  c->error = NULL;
+  *out = NULL;
+  *outlen = 0;
+
+  if (pthread_create(&thread, NULL, compilethread, &r) != 0) {
+    c->error = strdup("Unable to create a compile thread\n");
+    return -1;
+  }
+  pthread_join(thread, NULL);
+
+  if (r.status == 0) {
+    *out = c->result->buf;
+    *outlen = c->result->len;
+  }
+  return r.status;
+}
@@ -0,0 +1,34 @@
+#include <stddef.h>
+
+// The compiler as a library, for programs which compile from memory to
+// memory without running `bin/b`. Link with `bin/libcomp.a` and `-pthread`.
+//
+// Each compilation has a context from `newcompiler()`. Any number of
+// contexts can compile at the same time on different threads, but a
+// context only does one compilation at a time. A context can be used for
+// one compilation after another.
+
+struct compiler;
+
+// What to compile into. Zero for any of these is the default.
+struct compileoptions {
+  int object;       // Output an ELF object file instead of assembly (as `-c`)
+  int jobs;         // Number of code generation threads, or 0 (as `-j`)
+  int pretokenize;  // Tokenize the whole input up front (as `-P`)
+};
+
+// Return a new context to compile with `opts`, or NULL if there's no
+// memory for it. If `opts` is NULL, the defaults are used.
+struct compiler *newcompiler(struct compileoptions *opts);
+
+// Compile the `len` bytes of source at `src`. On success, return 0 and set
+// `*out` and `*outlen` to the output, which belongs to the context and is
+// kept until its next compilation. On failure, return -1; the message is
+// given by `compilererror()`.
+int compilebuffer(struct compiler *c, char *src, size_t len, char **out, size_t *outlen);
+
+// Return the message of the last compilation's error, or NULL if it had none
+char *compilererror(struct compiler *c);
+
+// Release a context, along with its output and error message
+void freecompiler(struct compiler *c);
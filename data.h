@@ -4,15 +4,43 @@
 
 // Global variables
 
-extern_ int Line;        // Current line number
-extern_ int Putback;     // Character "put back" by scanner
-extern_ int Functionid;  // Symbol ID of the current function
-extern_ int Globals;     // Index of next free global symbol slot
-extern_ int Locals;      // Index of next free local symbol slot
-extern_ FILE *Infile;
-extern_ FILE *Outfile;
-extern_ struct token Token;                  // Last token scanned
-extern_ char Text[TEXTLEN + 1];              // Last identifier, via `scanident()`
-extern_ struct symtable Symtable[NSYMBOLS];  // Global symbol table
+// Function bodies can be parsed and generated on several threads at once
+// (see `jobs.c`), so the state that this uses is per thread
+extern_ _Thread_local int Line;                       // Current line number
+extern_ _Thread_local int Functionid;                 // Symbol ID of the current function
+extern_ _Thread_local int Globals;                    // Number of global symbols
+extern_ _Thread_local int Locals;                     // Number of local symbols
+extern_ _Thread_local struct token Token;             // Last token scanned
+extern_ _Thread_local char *Text;                     // Last identifier or string literal scanned
+extern_ _Thread_local int Tokpos;                     // Index of the next token in `Tokens[]`
+extern_ _Thread_local struct output *Output;          // The section buffers being output to, see `emit.c`
+extern_ _Thread_local struct outbuf *Outfile;         // The buffer of the section being output to
+extern_ _Thread_local struct symtable *Globalsyms;    // Global symbol table, see `SYMBOL()`
+extern_ _Thread_local struct symtable *Localsyms;     // Local symbol table, see `SYMBOL()`
+extern_ _Thread_local int *ASTbuf;                    // Nodes of the current function's AST, see `ASTNODE()`
+extern_ _Thread_local void (*Fatalhook)(char *msg);   // If set, takes the message of a fatal error
 
-extern_ int O_dumpAST;
+extern_ _Thread_local unsigned int Texthash;  // Hash of the identifier in `Text`
+
+// The state shared by the threads working on a compilation is in the
+// compilation's context (see `definitions.h`), which `Ctx` points to
+extern_ _Thread_local struct compiler *Ctx;
+
+#define Inbuf (Ctx->inbuf)
+#define Inptr (Ctx->inptr)
+#define Inend (Ctx->inend)
+#define Tokens (Ctx->tokens)
+#define Ntokens (Ctx->ntokens)
+#define Names (Ctx->names)    // Interned strings, by name id
+#define Nnames (Ctx->nnames)  // Number of entries in `Names[]`
+
+#define O_dumpAST (Ctx->dumpAST)
+#define O_pretokenize (Ctx->pretokenize)
+#define O_saveAST (Ctx->saveAST)
+#define O_loadAST (Ctx->loadAST)
+#define O_cache (Ctx->cache)
+#define O_pipeline (Ctx->pipeline)
+#define O_jobs (Ctx->jobs)
+#define O_object (Ctx->object)
+#define O_run (Ctx->run)
+#define O_pipe (Ctx->pipe)
@@ -71,14 +71,14 @@ static int param_declaration(int id) {
 
   // Get any existing prototype parameter count
   if (param_id)
-    orig_paramcount = Symtable[id].numelems;
+    orig_paramcount = SYMBOL(id)->numelems;
 
   while (Token.token != T_RPAREN) {
     type = parse_type();
     ident();
 
     if (param_id) {
-      if (type != Symtable[id].type)
+      if (type != SYMBOL(id)->type)
         fatald("Type doesn't match prototype for parameter", paramcount + 1);
 
       param_id++;
@@ -100,29 +100,27 @@ static int param_declaration(int id) {
   }
 
   if ((id != -1) && (paramcount != orig_paramcount))
-    fatals("Parameter count mismatch for function", Symtable[id].name);
+    fatals("Parameter count mismatch for function", SYMBOL(id)->name);
 
   return paramcount;
 }
 
-// Parse the declaration of a function.
-// The identifier has been scanned and we have the type.
-struct ASTnode *function_declaration(int type) {
-  struct ASTnode *tree, *finalstatement;
-  int index, nameslot, endlabel, paramcount;
+// Parse a function's name and parameters, up to its body or the `;` of a
+// prototype. The identifier has been scanned and we have the type. Return
+// the function's symbol slot if its body follows, or -1 for a prototype.
+int function_header(int type) {
+  int index, nameslot, paramcount;
 
   // If identifier in `Text` exists and is a function, get its symbol table index
   if ((index = findsymbol(Text)) != -1) {
-    if (Symtable[index].stype != S_FUNCTION)
+    if (SYMBOL(index)->stype != S_FUNCTION)
       index = -1;
   }
 
-  // If existing function identifier not found, get a label ID for the end label
-  // and add a new function symbol to the symbol table.
-  if (index == -1) {
-    endlabel = genlabel();
-    nameslot = addglobal(Text, type, S_FUNCTION, C_GLOBAL, endlabel, 0);
-  }
+  // If existing function identifier not found, add a new function symbol
+  // to the symbol table. Its end label is given when the body is found.
+  if (index == -1)
+    nameslot = addglobal(Text, type, S_FUNCTION, C_GLOBAL, 0, 0);
 
   lparen();
   paramcount = param_declaration(index);
@@ -130,59 +128,106 @@ struct ASTnode *function_declaration(int type) {
 
   // If a new function declaration, update the function symbol table entry with the parameter count
   if (index == -1)
-    Symtable[index].numelems = paramcount;
+    SYMBOL(nameslot)->numelems = paramcount;
 
   if (Token.token == T_SEMI) {
     scan(&Token);
-    return NULL;
+    return -1;
   }
 
-  if (index == -1)
-    index = nameslot;
+  return (index == -1) ? nameslot : index;
+}
+
+// Parse the body of the function in symbol slot `index`, with return type
+// `type`, and return its AST
+int function_body(int index, int type) {
+  int tree, finalstatement;
 
   copyfuncparams(index);
 
   Functionid = index;  // Set global to the function's symbol table index
 
+  // The function's labels are numbered from 1, starting with its end label
+  genresetlabels();
+  SYMBOL(index)->endlabel = genlabel();
+
   tree = compound_statement();
 
   // If the function doesn't return `void`, ensure the last AST
   // operation in the compound statement was a `return` statement
   if (type != P_VOID) {
-    if (tree == NULL)
+    if (tree == NOAST)
       fatal("No statements in function with non-void type");
 
-    finalstatement = (tree->op == A_GLUE) ? tree->right : tree;
-    if (finalstatement == NULL || finalstatement->op != A_RETURN)
+    finalstatement = (ASTNODE(tree)->op == A_GLUE) ? ASTRIGHT(tree) : tree;
+    if (finalstatement == NOAST || ASTNODE(finalstatement)->op != A_RETURN)
       fatal("No `return` for function with non-void type");
   }
 
   return mkastunary(A_FUNCTION, type, tree, index);
 }
 
+// Parse the declaration of a function.
+// The identifier has been scanned and we have the type.
+// Return its AST, or `NOAST` if it's only a prototype.
+int function_declaration(int type) {
+  int index;
+
+  if ((index = function_header(type)) == -1)
+    return NOAST;
+
+  return function_body(index, type);
+}
+
 // Parse one or more global declarations, either variables or functions
 void global_declarations(void) {
-  struct ASTnode *tree;
+  int tree;
   int type;
+  int start;
+  int index;
 
   while (1) {
+    start = Tokpos - 1;  // With `-C`, where this declaration is in `Tokens[]`
     type = parse_type();
     ident();
 
-    if (Token.token == T_LPAREN) {
+    if (Token.token == T_LPAREN && O_jobs && !O_pipeline) {
+      // With `-j`, the function's body is parsed on a worker thread
+      if ((index = function_header(type)) == -1)
+        continue;  // Only a prototype; no body
+
+      parsequeue(index, type);
+    } else if (Token.token == T_LPAREN) {
+      if (O_cache)
+        cachebegin(start);  // Capture the function's output
+
       tree = function_declaration(type);
 
-      if (tree == NULL)  // Only a prototype; no body
+      if (tree == NOAST) {  // Only a prototype; no body
+        if (O_cache)
+          cacheend();
         continue;
+      }
 
       if (O_dumpAST) {
-        dumpAST(tree, NOLABEL, 0);
+        dumpAST(tree, 0);
         fprintf(stdout, "\n\n");
       }
 
-      genAST(tree, NOLABEL, 0);
+      if (O_saveAST)
+        saveAST(tree);  // Keep the tree for a later `-L` run
+      else if (O_pipeline)
+        genqueue(tree);  // Generate the code on another thread
+      else if (!O_cache || !cachelookup(tree))
+        genAST(tree, NOLABEL, 0);
+
+      if (O_cache)
+        cacheend();  // Output the function, from the cache or just generated
+      if (!O_saveAST && !O_jobs)
+        genflush(Output);
 
       freelocalsymbols();  // Free the symbols associated with this function
+      freeASTnodes();      // and its AST
     } else {
       variable_declaration(type, C_GLOBAL);
       semi();
@@ -1,31 +1,106 @@
 // Function prototypes for all compiler files
 
+// `compiler.c` (and see `compiler.h`)
+void addbuiltins(void);
+void compilesource(void);
+void freethread(void);
+
+// `input.c`
+void open_input(char *filename);
+void close_input(void);
+
+// `emit.c`
+struct outbuf *newoutbuf(void);
+void freeoutbuf(struct outbuf *o);
+struct output *newoutput(int fd);
+void freeoutput(struct output *o);
+void useoutput(struct output *o);
+void emitsection(int sec);
+void appendoutput(struct output *to, struct output *from);
+void outputbytes(struct output *o, char *p, size_t n);
+void writeoutput(struct output *o, char **directives);
+void flushsection(struct output *o, int sec, char *directive);
+void outwrite(struct outbuf *o, char *s, size_t n);
+void writebytes(int fd, char *p, size_t n);
+void emitn(char *s, int n);
+void emits(char *s);
+void emitc(int c);
+void emitd(long v);
+void emitf(char *fmt, ...);
+
+// `intern.c`
+int internid(char *s, int len, unsigned int hash);
+unsigned int strhash(char *s, int len);
+char *intern(char *s);
+void freenames(void);
+
+// `serialize.c`
+void open_astfile(char *filename, char *mode);
+void close_astfile(void);
+void saveglobalsym(int slot);
+void savestrlit(int label, char *strvalue);
+void saveAST(int tree);
+void loadASTfile(void);
+
 // `scanner.c`
 void reject_token(struct token *t);
 int scan(struct token *t);
+void tokenize(void);
+void free_tokens(void);
+void start_lexer(void);
+void stop_lexer(void);
+
+// `strpool.c`
+void poolstr(int label, char *str);
+void genstrpool(void);
+void freestrpool(void);
+
+// `cache.c`
+void open_cache(void);
+void cachebegin(int start);
+int cachelookup(int tree);
+void cacheend(void);
+
+// `jobs.c`
+void start_jobs(void);
+void genqueue(int tree);
+void parsequeue(int id, int type);
+void finish_jobs(void);
+void abandon_jobs(void);
 
 // `tree.c`
-struct ASTnode *mkastnode(int op, int type, struct ASTnode *left, struct ASTnode *mid, struct ASTnode *right, int intvalue);
-struct ASTnode *mkastleaf(int op, int type, int intvalue);
-struct ASTnode *mkastunary(int op, int type, struct ASTnode *left, int intvalue);
-void dumpAST(struct ASTnode *n, int label, int parentASTop);
+int mkastnode(int op, int type, int left, int mid, int right, int intvalue);
+int mkastleaf(int op, int type, int intvalue);
+int mkastunary(int op, int type, int left, int intvalue);
+int ASTsize(void);
+int *setASTsize(int nwords);
+void freeASTnodes(void);
+void freeASTbuf(void);
+int hassymbol(int op);
+void dumpAST(int n, int level);
 
 // `code_generation.c`
 int genlabel(void);
-int genAST(struct ASTnode *n, int label, int parentASTop);
+void genresetlabels(void);
+int genAST(int n, int label, int parentASTop);
 void genpreamble(void);
 void genpostamble(void);
+void genflush(struct output *o);
 void genfreeregs(void);
+void freegenstack(void);
 void genglobalsym(int id);
-int genglobalstr(char *strvalue);
+int genglobalstr(int id, char *strvalue);
 int genprimsize(int type);
 
+// `object_x86-64.c`
+void writeobject(void);
+int runobject(void);
+
 // `code_generation_x86-64.c`
-void cgtextseg();
-void cgdataseg();
 void freeall_registers(void);
 void cgpreamble(void);
 void cgpostamble(void);
+void cgflush(struct output *o);
 void cgfuncpreamble(int id);
 void cgfuncpostamble(int id);
 int cgloadint(int value, int type);
@@ -42,7 +117,8 @@ void cgcopyarg(int r, int argposition);
 int cgstoreglobal(int r, int id);
 int cgstorlocal(int r, int id);
 void cgglobalsym(int id);
-void cgglobalstr(int l, char *strvalue);
+void cgstrlabel(int l);
+void cgstrchars(char *s, int len, int end);
 int cgcompare_and_set(int ASTop, int r1, int r2);
 int cgcompare_and_jump(int ASTop, int r1, int r2, int label);
 void cglabel(int l);
@@ -64,10 +140,11 @@ int cgshl(int r1, int r2);
 int cgshr(int r1, int r2);
 
 // `expressions.c`
-struct ASTnode *binexpr(int ptp);
+int binexpr(int ptp);
+void freeexprstack(void);
 
 // `statements.c`
-struct ASTnode *compound_statement(void);
+int compound_statement(void);
 
 // `miscellaneous.c`
 void match(int t, char *what);
@@ -81,6 +158,7 @@ void fatal(char *s);
 void fatals(char *s1, char *s2);
 void fatald(char *s, int d);
 void fatalc(char *s, int c);
+void fatalmessage(char *msg);
 
 // `symbols.c`
 int findglobal(char *s);
@@ -88,12 +166,19 @@ int findlocal(char *s);
 int findsymbol(char *s);
 int addglobal(char *name, int type, int stype, int class, int endlabel, int size);
 int addlocal(char *name, int type, int stype, int class, int size);
+int restorelocal(struct symtable *sym);
 void copyfuncparams(int slot);
+void openscope(void);
+void closescope(void);
 void freelocalsymbols(void);
+void freesymbols(void);
+void freeglobalsymbols(void);
 
 // `declarations.c`
 void variable_declaration(int type, int class);
-struct ASTnode *function_declaration(int type);
+int function_header(int type);
+int function_body(int index, int type);
+int function_declaration(int type);
 void global_declarations(void);
 
 // `types.c`
@@ -101,4 +186,4 @@ int inttype(int type);
 int parse_type(void);
 int pointer_to(int type);
 int value_at(int type);
-struct ASTnode *modify_type(struct ASTnode *tree, int rtype, int op);
+int modify_type(int tree, int rtype, int op);
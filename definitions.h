@@ -2,11 +2,17 @@
 #include <stdio.h>
 #include <string.h>
 #include <ctype.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 // Struct and enum definitions
 
-#define TEXTLEN 512    // Length of symbols in input
-#define NSYMBOLS 1024  // Number of symbol table entries
+#define TEXTLEN 512       // Length of symbols in input
+#define INPUT_PADDING 64  // Zero bytes after the input buffer for look-ahead
+
+// FNV-1a hash of a string, one character at a time
+#define HASHINIT 2166136261u
+#define HASHSTEP(h, c) (((h) ^ (unsigned char)(c)) * 16777619u)
 
 // Token types
 enum {
@@ -58,11 +64,15 @@ enum {
   T_LBRACKET,
   T_RBRACKET,
   T_COMMA,
+  // A lexical error in `Tokens[]`, in place of the rest of the input
+  T_ERROR,
 };
 
 struct token {
   int token;     // From enum, above
   int intvalue;  // For `T_INTLIT`
+  int nameid;    // For `T_IDENT`, `T_STRLIT` and `T_ERROR`: interned name id, see `Names[]`
+  int line;      // For tokens in `Tokens[]`: the line the token was found on
 };
 
 // AST node types (op)
@@ -125,20 +135,33 @@ enum {
   P_LONGPTR,
 };
 
+// AST nodes.
+// The nodes of a function's tree are stored one after the other in the words
+// of `ASTbuf[]`, and a node is referred to by the index of its first word.
+// Each node is this header followed by the indices of the children that it
+// has: none for a leaf, just the left child for a unary node, the left and
+// right children for a binary node, and then the middle child.
 struct ASTnode {
-  int op;                // "Operation" to be performed on this tree
-  int type;              // Type of any expression this tree generates
-  int rvalue;            // True if the node is an r-value
-  struct ASTnode *left;  // Left, middle, and right child trees
-  struct ASTnode *mid;
-  struct ASTnode *right;
+  unsigned char op;     // "Operation" to be performed on this tree
+  unsigned char flags;  // Number of child indices (`AST_NCHILD`), and `AST_RVALUE`
+  unsigned short type;  // Type of any expression this tree generates
   union {
     int intvalue;  // For `A_INTLIT`: the integer value
     int id;        // For `A_IDENT` + `A_FUNCTION` + `A_FUNCCALL`: the symbol slot number
     int size;      // For `A_SCALE`: the size to scale by
+    int label;     // For `A_IF` + `A_WHILE`: the first of the node's two labels
   } v;
+  int child[];  // Left, right and middle child trees
 };
 
+#define NOAST 0            // Index of no node; the first words of `ASTbuf[]` are not a node
+#define AST_NCHILD 0x03    // Mask for the number of child indices in the flags
+#define AST_RVALUE 0x04    // Flag: the node is an r-value
+#define ASTNODE(n) ((struct ASTnode *)(ASTbuf + (n)))
+#define ASTLEFT(n) ((ASTNODE(n)->flags & AST_NCHILD) > 0 ? ASTNODE(n)->child[0] : NOAST)
+#define ASTRIGHT(n) ((ASTNODE(n)->flags & AST_NCHILD) > 1 ? ASTNODE(n)->child[1] : NOAST)
+#define ASTMID(n) ((ASTNODE(n)->flags & AST_NCHILD) > 2 ? ASTNODE(n)->child[2] : NOAST)
+
 #define NOREG -1   // Use when the AST generation functions have no register to return
 #define NOLABEL 0  // Use when we have no label to pass to `genAST()`
 
@@ -156,14 +179,130 @@ enum {
   C_PARAM,       // Locally visible function parameter
 };
 
+// Symbol slot numbers with this bit set are locals (see `symbols.c`)
+#define LOCALSYM 0x40000000
+#define SYMBOL(slot) \
+  (((slot) & LOCALSYM) ? &Localsyms[(slot) & ~LOCALSYM] : &Globalsyms[(slot)])
+
 // Symbol table structure
 struct symtable {
-  char *name;    // Name of a symbol
-  int type;      // Primitive type for the symbol
-  int stype;     // Structural type for the symbol
-  int class;     // Storage class for the symbol
-  int endlabel;  // For `S_FUNCTION`, the end label
-  int size;      // Number of elements in the symbol
-  int position;  // For locals, the negative offset from the stack base pointer
-  int numelems;  // For functions, the number of parameters
+  char *name;      // Name of a symbol, interned so it can be compared by pointer
+  int type;        // Primitive type for the symbol
+  int stype;       // Structural type for the symbol
+  int class;       // Storage class for the symbol
+  int endlabel;    // For `S_FUNCTION`, the end label
+  int size;        // Number of elements in the symbol
+  int position;    // For locals, the negative offset from the stack base pointer
+  int numelems;    // For functions, the number of parameters
+  int shadowed;    // For locals, the slot of the outer local with the same name, or -1
+  int scopestart;  // For locals, the number of locals when its scope was opened
+  int scopeend;    // For locals, the number of locals when its scope was closed, or 0
+};
+
+// A hash index from symbol names to slot numbers (see `symbols.c`)
+struct symindex {
+  int *slots;  // Symbol slot number + 1 for each entry; 0 is empty
+  int size;    // Number of entries, a power of 2
+  int count;   // Number of entries in use
+};
+
+// A buffer of assembly output (see `emit.c`)
+struct outbuf {
+  char *buf;   // The output
+  size_t len;  // Its length
+  size_t cap;  // and the capacity of `buf[]`
+};
+
+// Sections of the output, each of which is collected in its own buffer
+enum {
+  SEC_TEXT,
+  SEC_DATA,
+  SEC_RODATA,
+  SEC_BSS,
+  NSECTIONS
+};
+
+// The output of the compiler, or of one function, by section
+struct output {
+  struct outbuf *sec[NSECTIONS];
+  int fd;               // File that the sections are written to at the end, or -1
+  struct outbuf *mem;   // If set, the buffer they are written to instead
 };
+
+// The state of one compilation which is shared by the threads working on
+// it. Each of them has `Ctx` pointing to it, and the names in `data.h`, and
+// in the files given below, refer to its fields. Anything only used by one
+// thread at a time is per thread instead.
+struct compiler {
+  // Options
+  int dumpAST;      // `-T`
+  int pretokenize;  // `-P`
+  int saveAST;      // `-A`
+  int loadAST;      // `-L`
+  int cache;        // `-C`
+  int pipeline;     // `-p`
+  int jobs;         // `-j`: number of code generation threads, or 0
+  int object;       // `-c`: output an object file instead of assembly
+  int run;          // `-run`: run the program in memory instead of writing it out
+  int pipe;         // `-pipe`: send the assembly to `as` as it's generated
+
+  // The input (see `input.c` and `scanner.c`)
+  char *inbuf;           // Whole input, followed by `INPUT_PADDING` zero bytes
+  char *inptr;           // Next character to be scanned
+  char *inend;           // End of the input's contents
+  struct token *tokens;  // Whole input as tokens, via `tokenize()`
+  int ntokens;           // Number of entries in `tokens[]`
+
+  // Interned names (see `intern.c`)
+  char **names;
+  int nnames;
+  char *arenablocks;
+  char *arenaptr;
+  char *arenaend;
+  unsigned int *namehash;
+  int *namelen;
+  int namecap;
+  int *nameindex;
+  int nameindexsize;
+
+  // Global symbols (see `symbols.c`)
+  int globalcap;
+  struct symindex globalindex;
+  struct symtable **oldglobals;  // Copies of `Globalsyms[]` kept for `-j`, to be freed
+  int noldglobals;
+  int oldglobalcap;
+
+  // String literals (see `strpool.c`)
+  struct poolentry *pool;
+  int npool;
+  int poolcap;
+  pthread_mutex_t poollock;
+
+  // Functions generated on worker threads (see `jobs.c`)
+  struct job **joblist;
+  int njobs;
+  int jobcap;
+  int nextjob;
+  int nwritten;
+  int finishing;
+  int abandoned;
+  struct output *jobout;
+  pthread_t *workers;
+  int nworkers;
+  pthread_mutex_t joblock;
+  pthread_cond_t jobready;
+  pthread_cond_t jobdone;
+
+  // The lexer thread (see `scanner.c`)
+  struct ringslot *ring;
+  atomic_uint ringhead;
+  atomic_uint ringtail;
+  pthread_t lexthread;
+
+  // The result of `compilebuffer()` (see `compiler.c`)
+  struct outbuf *result;
+  char *error;
+};
+
+// Output a string literal, whose length is known at compile time
+#define EMIT(s) emitn(s, sizeof(s) - 1)
@@ -0,0 +1,206 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <unistd.h>
+
+// Assembly output buffering.
+// The code generators append their output to `Outfile`, an in-memory
+// buffer, instead of calling `fprintf()` for every instruction. There is a
+// buffer for each section of the output, and `Outfile` is the one for the
+// section being output to, so the assembly doesn't switch back and forth
+// between sections. At the end, each section is written to the output file
+// with one `write()`, or copied to a buffer when compiling into memory (see
+// `compiler.c`). With `-pipe`, the text section is written as it grows, so
+// that the assembler can work on it in the meantime.
+//
+// The function cache and the worker threads collect a function's output in
+// a set of buffers of its own, which is then appended to the sections of
+// the output (see `cache.c` and `jobs.c`).
+
+#define OUTBUF_SIZE 4096   // Initial size of a buffer
+#define FLUSH_SIZE 16384   // How much of a section `flushsection()` waits for
+
+// Each number from 00 to 99 as two digits, for `emitd()`
+static char Digitpairs[] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+// Return a new, empty output buffer
+struct outbuf *newoutbuf(void) {
+  struct outbuf *o;
+
+  if ((o = malloc(sizeof(struct outbuf))) == NULL || (o->buf = malloc(OUTBUF_SIZE)) == NULL)
+    fatal("Unable to `malloc` in `newoutbuf()`");
+  o->len = 0;
+  o->cap = OUTBUF_SIZE;
+  return o;
+}
+
+// Release an output buffer
+void freeoutbuf(struct outbuf *o) {
+  free(o->buf);
+  free(o);
+}
+
+// Make room for `n` more bytes in the buffer
+static void makeroom(struct outbuf *o, size_t n) {
+  o->cap = (o->cap * 2 > o->len + n) ? o->cap * 2 : o->len + n;
+  if ((o->buf = realloc(o->buf, o->cap)) == NULL)
+    fatal("Unable to `realloc` in `makeroom()`");
+}
+
+// Append `n` bytes at `s` to the buffer
+void outwrite(struct outbuf *o, char *s, size_t n) {
+  if (o->len + n > o->cap)
+    makeroom(o, n);
+  memcpy(o->buf + o->len, s, n);
+  o->len += n;
+}
+
+// Return a new set of empty section buffers, whose contents will be written
+// to `fd`, or -1 if they are to be appended to another set
+struct output *newoutput(int fd) {
+  struct output *o;
+
+  if ((o = malloc(sizeof(struct output))) == NULL)
+    fatal("Unable to `malloc` in `newoutput()`");
+  for (int i = 0; i < NSECTIONS; i++)
+    o->sec[i] = newoutbuf();
+  o->fd = fd;
+  o->mem = NULL;
+  return o;
+}
+
+// Release a set of section buffers
+void freeoutput(struct output *o) {
+  for (int i = 0; i < NSECTIONS; i++)
+    freeoutbuf(o->sec[i]);
+  free(o);
+}
+
+// Output to the set of section buffers `o`, starting in the text section
+void useoutput(struct output *o) {
+  Output = o;
+  Outfile = o->sec[SEC_TEXT];
+}
+
+// Output to section `sec` from now on
+void emitsection(int sec) {
+  Outfile = Output->sec[sec];
+}
+
+// Append each section of `from` to the same section of `to`
+void appendoutput(struct output *to, struct output *from) {
+  for (int i = 0; i < NSECTIONS; i++)
+    outwrite(to->sec[i], from->sec[i]->buf, from->sec[i]->len);
+}
+
+// Write `n` bytes at `p` to `fd`
+void writebytes(int fd, char *p, size_t n) {
+  ssize_t got;
+
+  for (size_t done = 0; done < n; done += got) {
+    if ((got = write(fd, p + done, n - done)) == -1) {
+      if (errno == EINTR) {
+        got = 0;
+        continue;
+      }
+      fprintf(stderr, "Unable to write output: %s\n", strerror(errno));
+      exit(1);
+    }
+  }
+}
+
+// Write `n` bytes at `p` to the file of `o`, or its buffer if it has one
+void outputbytes(struct output *o, char *p, size_t n) {
+  if (o->mem != NULL)
+    outwrite(o->mem, p, n);
+  else
+    writebytes(o->fd, p, n);
+}
+
+// Write each section of `o` which isn't empty to its file, headed by the
+// directive for the section in `directives[]`
+void writeoutput(struct output *o, char **directives) {
+  for (int i = 0; i < NSECTIONS; i++) {
+    if (o->sec[i]->len == 0)
+      continue;
+    outputbytes(o, directives[i], strlen(directives[i]));
+    outputbytes(o, o->sec[i]->buf, o->sec[i]->len);
+  }
+}
+
+// Write section `sec` of `o` so far to its file, headed by `directive`,
+// and empty its buffer, so that whatever reads the file can start on it.
+// Small amounts are left to build up first.
+void flushsection(struct output *o, int sec, char *directive) {
+  struct outbuf *b = o->sec[sec];
+
+  if (o->fd == -1 || b->len < FLUSH_SIZE)
+    return;
+  writebytes(o->fd, directive, strlen(directive));
+  writebytes(o->fd, b->buf, b->len);
+  b->len = 0;
+}
+
+// Output `n` characters at `s`
+void emitn(char *s, int n) {
+  outwrite(Outfile, s, n);
+}
+
+// Output a string
+void emits(char *s) {
+  outwrite(Outfile, s, strlen(s));
+}
+
+// Output a character
+void emitc(int c) {
+  if (Outfile->len == Outfile->cap)
+    makeroom(Outfile, 1);
+  Outfile->buf[Outfile->len++] = c;
+}
+
+// Output an integer in decimal. The digits are worked out two at a time
+// from the right.
+void emitd(long v) {
+  char digits[24], *p = digits + sizeof(digits);
+  unsigned long u = (v < 0) ? -(unsigned long)v : v;
+
+  while (u >= 100) {
+    p -= 2;
+    memcpy(p, Digitpairs + (u % 100) * 2, 2);
+    u /= 100;
+  }
+  if (u >= 10) {
+    p -= 2;
+    memcpy(p, Digitpairs + u * 2, 2);
+  } else
+    *--p = '0' + u;
+  if (v < 0)
+    *--p = '-';
+
+  emitn(p, digits + sizeof(digits) - p);
+}
+
+// Output text formatted as by `printf()`, for anything that isn't worth
+// building from the routines above
+void emitf(char *fmt, ...) {
+  va_list ap;
+  int n;
+
+  va_start(ap, fmt);
+  n = vsnprintf(Outfile->buf + Outfile->len, Outfile->cap - Outfile->len, fmt, ap);
+  va_end(ap);
+
+  // If it didn't fit, make room and do it again
+  if (n >= Outfile->cap - Outfile->len) {
+    makeroom(Outfile, n + 1);
+    va_start(ap, fmt);
+    vsnprintf(Outfile->buf + Outfile->len, Outfile->cap - Outfile->len, fmt, ap);
+    va_end(ap);
+  }
+
+  Outfile->len += n;
+}
@@ -4,90 +4,136 @@
 
 // Parsing of expressions with Pratt parsing
 
-// Parse a list of 0+ comma-separated expressions and return an AST composed of
-// `A_GLUE` nodes, with the left-hand child being the sub-tree of previous
-// expressions (or NULL), and the right-hand child being the next expression.
-// Each `A_GLUE` node will have its size field set to the number of expressions
-// in the tree at this point. If no expressions are parsed, NULL is returned.
-static struct ASTnode *expression_list(void) {
-  struct ASTnode *tree = NULL;
-  struct ASTnode *child = NULL;
-  int exprcount = 0;
-
-  while (Token.token != T_RPAREN) {
-    child = binexpr(0);
-    exprcount++;
-
-    tree = mkastnode(A_GLUE, P_NONE, tree, NULL, child, exprcount);
-
-    switch (Token.token) {
-      case T_COMMA:
-        scan(&Token);
-        break;
-      case T_RPAREN:
-        break;
-      default:
-        fatald("Unexpected token in expression list", Token.token);
-    }
-  }
+// The parser doesn't recurse. Each place where the recursive descent would
+// call `binexpr()` or `prefix()` for a sub-expression instead pushes a frame
+// saying what to do with the sub-expression's tree once it has been parsed,
+// so deeply nested expressions only use space in `Exprstack[]`.
+
+// What a frame on the expression stack is waiting for
+enum {
+  E_BINEXPR,  // The left or right operand of a binary operator
+  E_PREFIX,   // The operand of a prefix operator
+  E_PAREN,    // A parenthesised expression
+  E_INDEX,    // The index of an array access
+  E_ARGS,     // The next argument of a function call
+};
 
-  return tree;
-}
+struct exprframe {
+  int kind;  // One of the `E_` values above
+  int step;  // For `E_BINEXPR`: 0 while parsing the left operand, 1 for the right
+  int ptp;   // For `E_BINEXPR`: the previous token precedence
+  int token; // For `E_BINEXPR` and `E_PREFIX`: the operator token
+  int tree;  // The left tree, the array's base, or the arguments so far
+  int id;    // For `E_INDEX` and `E_ARGS`: the symbol slot number
+  int count; // For `E_ARGS`: the number of arguments so far
+};
 
-// Parse a function call and return its AST
-static struct ASTnode *funccall(void) {
-  struct ASTnode *tree;
-  int id;
+#define INITIAL_EXPRFRAMES 64  // Initial capacity of `Exprstack[]`
 
-  if ((id = findsymbol(Text)) == -1) {
-    fatals("Undeclared function", Text);
-  }
+static _Thread_local struct exprframe *Exprstack;  // Frames of the expressions being parsed
+static _Thread_local int Exprdepth;                // Number of frames in use
+static _Thread_local int Exprcap;                  // Capacity of `Exprstack[]`
 
-  if (Symtable[id].stype != S_FUNCTION) {
-    fatals("Not a function", Text);
-  }
+// Push a new frame of the given kind and return it
+static struct exprframe *pushexpr(int kind) {
+  struct exprframe *f;
 
-  lparen();
-  tree = expression_list();
+  if (Exprdepth == Exprcap) {
+    Exprcap = Exprcap ? Exprcap * 2 : INITIAL_EXPRFRAMES;
+    if ((Exprstack = realloc(Exprstack, Exprcap * sizeof(struct exprframe))) == NULL)
+      fatal("Unable to `realloc` in `pushexpr()`");
+  }
 
-  // TODO: Check type of each argument against the function's prototype
+  f = &Exprstack[Exprdepth++];
+  f->kind = kind;
+  f->step = 0;
+  f->tree = NOAST;
+  return f;
+}
 
-  tree = mkastunary(A_FUNCCALL, Symtable[id].type, tree, id);
-  rparen();
-  return tree;
+// Release this thread's `Exprstack[]`
+void freeexprstack(void) {
+  free(Exprstack);
+  Exprstack = NULL;
+  Exprdepth = Exprcap = 0;
 }
 
-// Parse the index into an array and return an AST node for it
-static struct ASTnode *array_access(void) {
-  struct ASTnode *left, *right;
+// Start parsing the index into an array. The identifier is in `Text` and the
+// current token is the '['.
+static void array_access(void) {
+  struct exprframe *f;
   int id;
 
-  if ((id = findsymbol(Text)) == -1 || Symtable[id].stype != S_ARRAY) {
+  if ((id = findsymbol(Text)) == -1 || SYMBOL(id)->stype != S_ARRAY) {
     fatals("Undeclared array", Text);
   }
 
-  left = mkastleaf(A_ADDR, Symtable[id].type, id);
+  f = pushexpr(E_INDEX);
+  f->id = id;
+  f->tree = mkastleaf(A_ADDR, SYMBOL(id)->type, id);
 
   scan(&Token);  // Get the '['
-  right = binexpr(0);
+}
+
+// Finish an array access, given the AST of the index, and return its AST
+static int end_array_access(int left, int right, int id) {
   match(T_RBRACKET, "]");
 
-  if (!inttype(right->type))
+  if (!inttype(ASTNODE(right)->type))
     fatal("Array index is not of integer type");
 
-  right = modify_type(right, left->type, A_ADD);  // Scale index by size of element's type
+  right = modify_type(right, ASTNODE(left)->type, A_ADD);  // Scale index by size of element's type
 
   // Return an AST node where the array's base has the offset added to it.
   // Dereference the element. It's still an l-value at this point.
-  left = mkastnode(A_ADD, Symtable[id].type, left, NULL, right, 0);
-  left = mkastunary(A_DEREF, value_at(left->type), left, 0);
+  left = mkastnode(A_ADD, SYMBOL(id)->type, left, NOAST, right, 0);
+  left = mkastunary(A_DEREF, value_at(ASTNODE(left)->type), left, 0);
   return left;
 }
 
-// Parse a postfix expression and return an AST node representing it.
+// Finish a function call, given the AST of its arguments, and return its AST.
+// The arguments are a tree of `A_GLUE` nodes, with the left-hand child being
+// the sub-tree of previous arguments (or NOAST), and the right-hand child being
+// the next argument. Each `A_GLUE` node has its size field set to the number
+// of arguments in the tree at this point.
+static int end_funccall(int tree, int id) {
+  // TODO: Check type of each argument against the function's prototype
+
+  tree = mkastunary(A_FUNCCALL, SYMBOL(id)->type, tree, id);
+  rparen();
+  return tree;
+}
+
+// Start parsing a function call. The identifier is in `Text` and the current
+// token is the '('. Return the call's AST if it has no arguments, or NOAST
+// if an `E_ARGS` frame has been pushed to collect them.
+static int funccall(void) {
+  struct exprframe *f;
+  int id;
+
+  if ((id = findsymbol(Text)) == -1) {
+    fatals("Undeclared function", Text);
+  }
+
+  if (SYMBOL(id)->stype != S_FUNCTION) {
+    fatals("Not a function", Text);
+  }
+
+  lparen();
+  if (Token.token == T_RPAREN)
+    return end_funccall(NOAST, id);
+
+  f = pushexpr(E_ARGS);
+  f->id = id;
+  f->count = 0;
+  return NOAST;
+}
+
+// Parse a postfix expression and return an AST node representing it, or
+// NOAST if a frame has been pushed for an array index or function arguments.
 // The identifier is already in `Text`.
-static struct ASTnode *postfix(void) {
-  struct ASTnode *n;
+static int postfix(void) {
+  int n;
   int id;
 
   scan(&Token);  // Either a function call, array index, or variable
@@ -95,31 +141,34 @@ static struct ASTnode *postfix(void) {
   if (Token.token == T_LPAREN)
     return funccall();
 
-  if (Token.token == T_LBRACKET)
-    return array_access();
+  if (Token.token == T_LBRACKET) {
+    array_access();
+    return NOAST;
+  }
 
-  if ((id = findsymbol(Text)) == -1 || Symtable[id].stype != S_VARIABLE)
+  if ((id = findsymbol(Text)) == -1 || SYMBOL(id)->stype != S_VARIABLE)
     fatals("Unknown variable", Text);
 
   switch (Token.token) {
     case T_INC:
       scan(&Token);
-      n = mkastleaf(A_POSTINC, Symtable[id].type, id);
+      n = mkastleaf(A_POSTINC, SYMBOL(id)->type, id);
       break;
     case T_DEC:
       scan(&Token);
-      n = mkastleaf(A_POSTDEC, Symtable[id].type, id);
+      n = mkastleaf(A_POSTDEC, SYMBOL(id)->type, id);
       break;
     default:
-      n = mkastleaf(A_IDENT, Symtable[id].type, id);
+      n = mkastleaf(A_IDENT, SYMBOL(id)->type, id);
   }
 
   return n;
 }
 
-// Parse a primary factor and return an AST node representing it
-static struct ASTnode *primary(void) {
-  struct ASTnode *n;
+// Parse a primary factor and return an AST node representing it, or NOAST if
+// a frame has been pushed for a sub-expression which still has to be parsed
+static int primary(void) {
+  int n;
   int id;
 
   switch (Token.token) {
@@ -131,7 +180,7 @@ static struct ASTnode *primary(void) {
       break;
 
     case T_STRLIT:
-      id = genglobalstr(Text);
+      id = genglobalstr(Token.nameid, Text);
       n = mkastleaf(A_STRLIT, P_CHARPTR, id);  // `id` is the string's label
       break;
 
@@ -140,9 +189,8 @@ static struct ASTnode *primary(void) {
 
     case T_LPAREN:  // Parenthesised expression
       scan(&Token);
-      n = binexpr(0);
-      rparen();
-      return n;
+      pushexpr(E_PAREN);
+      return NOAST;
 
     default:
       fatald("Syntax error, token", Token.token);
@@ -192,143 +240,203 @@ static int op_precedence(int tokentype) {
   return prec;
 }
 
-// Parse a prefix expression and return an AST node representing it
-static struct ASTnode *prefix(void) {
-  struct ASTnode *tree;
-
-  switch (Token.token) {
-    case T_AMPER:
-      // Get next token and parse it recursively as a prefix expression
+// Parse the operand of a binary operator whose precedence is `ptp`, as far as
+// its first primary factor, and return that factor's AST. Frames are pushed
+// for the enclosing binary expression, any prefix operators, and any
+// parentheses, array indexes or function arguments that the factor opens.
+static int operand(int ptp) {
+  struct exprframe *f;
+  int tree;
+
+  while (1) {
+    f = pushexpr(E_BINEXPR);
+    f->ptp = ptp;
+
+    // Prefix operators apply to the factor after them
+    while (Token.token == T_AMPER || Token.token == T_STAR || Token.token == T_MINUS ||
+           Token.token == T_INVERT || Token.token == T_LOGNOT || Token.token == T_INC ||
+           Token.token == T_DEC) {
+      pushexpr(E_PREFIX)->token = Token.token;
       scan(&Token);
-      tree = prefix();
+    }
+
+    if ((tree = primary()) != NOAST)
+      return tree;
+
+    // A sub-expression was opened, so parse it from the lowest precedence
+    ptp = 0;
+  }
+}
 
-      if (tree->op != A_IDENT)
+// Apply the prefix operator `token` to the AST `tree`
+// and return an AST node representing it
+static int prefix(int token, int tree) {
+  switch (token) {
+    case T_AMPER:
+      if (ASTNODE(tree)->op != A_IDENT)
         fatal("& operator must be followed by an identifier");
 
       // Not a parent node; `A_IDENT` replaced with `A_ADDR`
-      tree->op = A_ADDR;
-      tree->type = pointer_to(tree->type);
+      ASTNODE(tree)->op = A_ADDR;
+      ASTNODE(tree)->type = pointer_to(ASTNODE(tree)->type);
       // `tree` is an l-value...we want address of the variable, not its value
       break;
     case T_STAR:
-      scan(&Token);
-      tree = prefix();
-
-      if (tree->op != A_IDENT && tree->op != A_DEREF)
+      if (ASTNODE(tree)->op != A_IDENT && ASTNODE(tree)->op != A_DEREF)
         fatal("* operator must be followed by an identifier or *");
 
-      tree = mkastunary(A_DEREF, value_at(tree->type), tree, 0);  // Parent node...
+      tree = mkastunary(A_DEREF, value_at(ASTNODE(tree)->type), tree, 0);  // Parent node...
       break;
     case T_MINUS:
-      scan(&Token);
-      tree = prefix();
-      tree->rvalue = 1;
+      ASTNODE(tree)->flags |= AST_RVALUE;
       // Widen to int so that it's signed (char may not be). Must be signed to negate.
       tree = modify_type(tree, P_INT, 0);
-      tree = mkastunary(A_NEGATE, tree->type, tree, 0);
+      tree = mkastunary(A_NEGATE, ASTNODE(tree)->type, tree, 0);
       break;
     case T_INVERT:
-      scan(&Token);
-      tree = prefix();
-      tree->rvalue = 1;
-      tree = mkastunary(A_INVERT, tree->type, tree, 0);
+      ASTNODE(tree)->flags |= AST_RVALUE;
+      tree = mkastunary(A_INVERT, ASTNODE(tree)->type, tree, 0);
       break;
     case T_LOGNOT:
-      scan(&Token);
-      tree = prefix();
-      tree->rvalue = 1;
-      tree = mkastunary(A_LOGNOT, tree->type, tree, 0);
+      ASTNODE(tree)->flags |= AST_RVALUE;
+      tree = mkastunary(A_LOGNOT, ASTNODE(tree)->type, tree, 0);
       break;
     case T_INC:
-      scan(&Token);
-      tree = prefix();
-
-      if (tree->op != A_IDENT)
+      if (ASTNODE(tree)->op != A_IDENT)
         fatal("++ operator must be followed by an identifier");
 
-      tree = mkastunary(A_PREINC, tree->type, tree, 0);
+      tree = mkastunary(A_PREINC, ASTNODE(tree)->type, tree, 0);
       break;
     case T_DEC:
-      scan(&Token);
-      tree = prefix();
-
-      if (tree->op != A_IDENT)
+      if (ASTNODE(tree)->op != A_IDENT)
         fatal("-- operator must be followed by an identifier");
 
-      tree = mkastunary(A_PREDEC, tree->type, tree, 0);
+      tree = mkastunary(A_PREDEC, ASTNODE(tree)->type, tree, 0);
       break;
-    default:
-      tree = primary();  // Identifier or integer literal...
   }
 
   return tree;
 }
 
+// Join the binary operator `tokentype` with its left and right trees
+// and return an AST node representing it
+static int binop(int tokentype, int left, int right) {
+  int ltemp, rtemp;
+  int ASTop = binastop(tokentype);
+
+  if (ASTop == A_ASSIGN) {
+    ASTNODE(right)->flags |= AST_RVALUE;  // Mark the right as an r-value
+    right = modify_type(right, ASTNODE(left)->type, 0);
+    if (right == NOAST)
+      fatal("Incompatible expression in assignment");
+
+    ltemp = left;  // Swap
+    left = right;
+    right = ltemp;
+  } else {
+    // Not doing an assignment, so both trees should be r-values...
+    ASTNODE(left)->flags |= AST_RVALUE;
+    ASTNODE(right)->flags |= AST_RVALUE;
+
+    ltemp = modify_type(left, ASTNODE(right)->type, ASTop);
+    rtemp = modify_type(right, ASTNODE(left)->type, ASTop);
+
+    if (ltemp == NOAST && rtemp == NOAST)
+      fatal("Incompatible types in binary expression");
+
+    if (ltemp != NOAST)  // Left <= right
+      left = ltemp;
+    if (rtemp != NOAST)  // Right <= left
+      right = rtemp;
+  }
+
+  // Convert the token into an AST operation at the same time.
+  return mkastnode(binastop(tokentype), ASTNODE(left)->type, left, NOAST, right, 0);
+}
+
 // Return an AST tree whose root is a binary operator
-struct ASTnode *binexpr(int ptp)  // `ptp`: previous token precedence
+int binexpr(int ptp)  // `ptp`: previous token precedence
 {
-  struct ASTnode *left, *right;
-  struct ASTnode *ltemp, *rtemp;
-  int ASTop;
-  int tokentype;
+  struct exprframe *f;
+  int base = Exprdepth;
+  int tree, tokentype;
 
   // Get primary tree on the left. Fetch next token at the same time.
-  left = prefix();
+  tree = operand(ptp);
 
-  tokentype = Token.token;
-  if (tokentype == T_SEMI || tokentype == T_RPAREN || tokentype == T_RBRACKET) {
-    left->rvalue = 1;
-    return left;
-  }
+  // `tree` is a finished sub-expression; hand it to the innermost frame
+  while (Exprdepth > base) {
+    f = &Exprstack[Exprdepth - 1];
 
-  // While current token precedence > previous token precedence...
-  while ((op_precedence(tokentype) > ptp) ||
-         (rightassoc(tokentype) && op_precedence(tokentype) == ptp)) {
-    // Read in the next integer literal or identifier
-    scan(&Token);
-
-    // Recursively build a sub-tree with binexpr(<token precedence>)
-    right = binexpr(OpPrec[tokentype]);
-
-    ASTop = binastop(tokentype);
-
-    if (ASTop == A_ASSIGN) {
-      right->rvalue = 1;  // Mark the right as an r-value
-      right = modify_type(right, left->type, 0);
-      if (right == NULL)
-        fatal("Incompatible expression in assignment");
-
-      ltemp = left;  // Swap
-      left = right;
-      right = ltemp;
-    } else {
-      // Not doing an assignment, so both trees should be r-values...
-      left->rvalue = 1;
-      right->rvalue = 1;
-
-      ltemp = modify_type(left, right->type, ASTop);
-      rtemp = modify_type(right, left->type, ASTop);
-
-      if (ltemp == NULL && rtemp == NULL)
-        fatal("Incompatible types in binary expression");
-
-      if (ltemp != NULL)  // Left <= right
-        left = ltemp;
-      if (rtemp != NULL)  // Right <= left
-        right = rtemp;
-    }
-    // Join that sub-tree with the left-hand sub-tree.
-    // Convert the token into an AST operation at the same time.
-    left = mkastnode(binastop(tokentype), left->type, left, NULL, right, 0);
-
-    tokentype = Token.token;  // Update details of current token
-    if (tokentype == T_SEMI || tokentype == T_RPAREN || tokentype == T_RBRACKET) {
-      left->rvalue = 1;
-      return left;
+    switch (f->kind) {
+      case E_PREFIX:
+        tree = prefix(f->token, tree);
+        Exprdepth--;
+        break;
+
+      case E_PAREN:
+        rparen();
+        Exprdepth--;
+        break;
+
+      case E_INDEX:
+        tree = end_array_access(f->tree, tree, f->id);
+        Exprdepth--;
+        break;
+
+      case E_ARGS:
+        f->count++;
+        f->tree = mkastnode(A_GLUE, P_NONE, f->tree, NOAST, tree, f->count);
+
+        switch (Token.token) {
+          case T_COMMA:
+            scan(&Token);
+            if (Token.token == T_RPAREN) {
+              tree = end_funccall(f->tree, f->id);
+              Exprdepth--;
+            } else
+              tree = operand(0);
+            break;
+          case T_RPAREN:
+            tree = end_funccall(f->tree, f->id);
+            Exprdepth--;
+            break;
+          default:
+            fatald("Unexpected token in expression list", Token.token);
+        }
+        break;
+
+      case E_BINEXPR:
+        // Join the right-hand sub-tree with the left-hand sub-tree
+        if (f->step == 1)
+          tree = binop(f->token, f->tree, tree);
+
+        tokentype = Token.token;
+        if (tokentype == T_SEMI || tokentype == T_RPAREN || tokentype == T_RBRACKET) {
+          ASTNODE(tree)->flags |= AST_RVALUE;
+          Exprdepth--;
+          break;
+        }
+
+        // While current token precedence > previous token precedence...
+        if ((op_precedence(tokentype) > f->ptp) ||
+            (rightassoc(tokentype) && op_precedence(tokentype) == f->ptp)) {
+          // Read in the next integer literal or identifier,
+          // and build a sub-tree with the token's precedence
+          f->step = 1;
+          f->token = tokentype;
+          f->tree = tree;
+          scan(&Token);
+          tree = operand(OpPrec[tokentype]);
+          break;
+        }
+
+        // Return the current tree when current precedence <= previous precedence
+        ASTNODE(tree)->flags |= AST_RVALUE;
+        Exprdepth--;
+        break;
     }
   }
 
-  // Return the current tree when current precedence <= previous precedence
-  left->rvalue = 1;
-  return left;
+  return tree;
 }
@@ -0,0 +1,67 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Source input buffering.
+// The whole input file is read into memory so that the scanner can walk a
+// pointer through it instead of calling `fgetc()` for every character.
+
+#define INPUT_CHUNK 65536  // Read size when the file size isn't known up front
+
+// Read the named file into `Inbuf[]`. The buffer is followed by `INPUT_PADDING`
+// zero bytes so that the scanner can look past the end without bounds checks.
+void open_input(char *filename) {
+  struct stat sb;
+  size_t size, cap, n;
+  ssize_t got;
+  int fd;
+
+  if ((fd = open(filename, O_RDONLY)) == -1 || fstat(fd, &sb) == -1) {
+    fprintf(stderr, "Unable to open %s: %s\n", filename, strerror(errno));
+    exit(1);
+  }
+
+  // Regular files are read with one `read()` of the right size; anything
+  // else (pipes, devices) is read in large chunks into a growing buffer
+  cap = S_ISREG(sb.st_mode) ? (size_t)sb.st_size : INPUT_CHUNK;
+  if ((Inbuf = malloc(cap + INPUT_PADDING)) == NULL)
+    fatal("Unable to `malloc` in `open_input()`");
+
+  for (size = 0;; size += got) {
+    if (size == cap) {
+      if (S_ISREG(sb.st_mode))
+        break;
+      cap *= 2;
+      if ((Inbuf = realloc(Inbuf, cap + INPUT_PADDING)) == NULL)
+        fatal("Unable to `realloc` in `open_input()`");
+    }
+
+    n = cap - size;
+    if ((got = read(fd, Inbuf + size, n)) == -1) {
+      if (errno == EINTR) {
+        got = 0;
+        continue;
+      }
+      fprintf(stderr, "Unable to read %s: %s\n", filename, strerror(errno));
+      exit(1);
+    }
+    if (got == 0)
+      break;
+  }
+
+  close(fd);
+
+  memset(Inbuf + size, 0, INPUT_PADDING);
+  Inptr = Inbuf;
+  Inend = Inbuf + size;
+}
+
+// Release the input buffer
+void close_input(void) {
+  free(Inbuf);
+  Inbuf = Inptr = Inend = NULL;
+}
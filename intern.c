@@ -0,0 +1,131 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+
+// String interning.
+// Each distinct identifier or string literal is stored once, so names can be
+// compared by pointer. Strings live in large arena blocks; an open-addressing
+// hash table of name ids finds an existing copy. Each block starts with a
+// pointer to the one before, so that they can all be freed.
+
+#define ARENA_BLOCK 65536   // Bytes per block of string storage
+#define INITIAL_NAMES 1024  // Initial capacity of `Names[]`, a power of 2
+
+// The tables are in the compilation's context, as all its threads share them
+#define Arenablocks (Ctx->arenablocks)      // The newest block
+#define Arenaptr (Ctx->arenaptr)            // Next free byte in the current block
+#define Arenaend (Ctx->arenaend)            // End of the current block
+#define Namehash (Ctx->namehash)            // Hash of each name, by id
+#define Namelen (Ctx->namelen)              // Length of each name, by id
+#define Namecap (Ctx->namecap)              // Capacity of `Names[]`, `Namehash[]` and `Namelen[]`
+#define Nameindex (Ctx->nameindex)          // Hash table of name ids + 1 (0 is an empty slot)
+#define Nameindexsize (Ctx->nameindexsize)  // Slots in `Nameindex[]`, a power of 2
+
+// Copy `len` characters of `s` into arena storage and NUL-terminate them
+static char *arenacopy(char *s, int len) {
+  char *p;
+
+  if (Arenaend - Arenaptr < len + 1) {
+    int size = sizeof(char *) + ((len + 1 > ARENA_BLOCK) ? len + 1 : ARENA_BLOCK);
+    if ((p = malloc(size)) == NULL)
+      fatal("Unable to `malloc` in `arenacopy()`");
+    *(char **)p = Arenablocks;
+    Arenablocks = p;
+    Arenaptr = p + sizeof(char *);
+    Arenaend = p + size;
+  }
+
+  p = Arenaptr;
+  memcpy(p, s, len);
+  p[len] = '\0';
+  Arenaptr += len + 1;
+  return p;
+}
+
+// Double the capacity of the name arrays and rebuild the hash table
+static void growindex(void) {
+  int i, slot;
+
+  Namecap = Namecap ? Namecap * 2 : INITIAL_NAMES;
+  Names = realloc(Names, Namecap * sizeof(char *));
+  Namehash = realloc(Namehash, Namecap * sizeof(unsigned int));
+  Namelen = realloc(Namelen, Namecap * sizeof(int));
+
+  // Keep the table at most half full
+  free(Nameindex);
+  Nameindexsize = Namecap * 2;
+  Nameindex = calloc(Nameindexsize, sizeof(int));
+
+  if (Names == NULL || Namehash == NULL || Namelen == NULL || Nameindex == NULL)
+    fatal("Unable to allocate the string intern table");
+
+  for (i = 0; i < Nnames; i++) {
+    slot = Namehash[i] & (Nameindexsize - 1);
+    while (Nameindex[slot])
+      slot = (slot + 1) & (Nameindexsize - 1);
+    Nameindex[slot] = i + 1;
+  }
+}
+
+// Return the id of the interned copy of the `len` characters at `s`, whose
+// hash (via `HASHSTEP()`) is `hash`. The string is added if it's new.
+// `Names[id]` is the one copy of the string.
+int internid(char *s, int len, unsigned int hash) {
+  int slot, id;
+
+  if (Nnames == Namecap)
+    growindex();
+
+  // Look for the string, stopping at the first empty slot
+  for (slot = hash & (Nameindexsize - 1); (id = Nameindex[slot]); slot = (slot + 1) & (Nameindexsize - 1)) {
+    id--;
+    if (Namehash[id] == hash && Namelen[id] == len && !memcmp(Names[id], s, len))
+      return id;
+  }
+
+  // Not found, so add it in the empty slot
+  id = Nnames++;
+  Names[id] = arenacopy(s, len);
+  Namehash[id] = hash;
+  Namelen[id] = len;
+  Nameindex[slot] = id + 1;
+  return id;
+}
+
+// Return the hash (via `HASHSTEP()`) of the `len` characters at `s`
+unsigned int strhash(char *s, int len) {
+  unsigned int h = HASHINIT;
+
+  for (int i = 0; i < len; i++)
+    h = HASHSTEP(h, s[i]);
+
+  return h;
+}
+
+// Return the interned copy of the NUL-terminated string `s`
+char *intern(char *s) {
+  int len = strlen(s);
+  int id = internid(s, len, strhash(s, len));  // May move `Names[]`
+
+  return Names[id];
+}
+
+// Release all the interned strings and the tables
+void freenames(void) {
+  char *prev;
+
+  for (; Arenablocks != NULL; Arenablocks = prev) {
+    prev = *(char **)Arenablocks;
+    free(Arenablocks);
+  }
+  free(Names);
+  free(Namehash);
+  free(Namelen);
+  free(Nameindex);
+  Names = NULL;
+  Namehash = NULL;
+  Namelen = NULL;
+  Nameindex = NULL;
+  Arenaptr = Arenaend = NULL;
+  Nnames = Namecap = Nameindexsize = 0;
+}
@@ -0,0 +1,390 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <pthread.h>
+#include <setjmp.h>
+
+// Parallel parsing and code generation.
+// With `-j`, the main thread parses the global declarations and the
+// function headers, and skips over each function body by matching its
+// braces in `Tokens[]`. Each body is queued for a pool of worker threads,
+// which parse it and generate its code once the main thread has reached
+// the end of the input; from then on, the symbol table doesn't change.
+// When reading an AST file with `-L`, the function trees are queued for
+// code generation in the same way.
+//
+// The output is kept as a list of pieces in source order: each function's
+// string literals and code, and the main thread's output (global variables)
+// between them. Each piece has its own section buffers, which are added to
+// the output's once it and all the pieces before it are finished, so the
+// output is the same as from a serial build: labels are numbered within
+// each function.
+//
+// Parser and code generation state is per thread (see `data.h`). A queued
+// function takes the global symbol table as it was, along with how many
+// globals had been declared; the table keeps old copies when it grows, so
+// this stays valid. A fatal error is kept with the piece it happened in
+// and reported when that piece would be written, so the first error in the
+// source is the one reported. The input is tokenized before any of it is
+// parsed, so a lexical error is left in `Tokens[]` as a `T_ERROR` token to
+// be reported by whichever thread parses up to it (see `tokenize()`).
+//
+// The list and the threads belong to the compilation (see `compiler.c`),
+// and each worker is given its context when it starts.
+
+struct job {
+  int done;                  // True once the piece's output is complete
+  int isfunc;                // True for a function, false for main thread output
+  int start;                 // For a body to parse: the position of its `{` in `Tokens[]`
+  int type;                  // and the function's type
+  int *ast;                  // For a tree from `-L`: a copy of `ASTbuf[]`
+  int root;                  // and its root node
+  struct symtable *locals;   // and a copy of the function's locals
+  int nlocals;               // and how many there are
+  struct symtable *globals;  // The global symbol table when it was queued
+  int nglobals;              // and the number of globals in it
+  int funcid;                // The function's symbol slot
+  int line;                  // The line it was queued on, for error messages
+  struct output *out;        // The piece's output
+  char *error;               // The message of a fatal error in this piece
+};
+
+#define Jobs (Ctx->joblist)         // The pieces of output, in order
+#define Njobs (Ctx->njobs)           // Number of pieces
+#define Jobcap (Ctx->jobcap)         // Capacity of `Jobs[]`
+#define Nextjob (Ctx->nextjob)       // Lowest piece that may be a function not yet started
+#define Nwritten (Ctx->nwritten)     // Pieces added to the output so far
+#define Finishing (Ctx->finishing)   // Set when no more functions will be queued
+#define Abandoned (Ctx->abandoned)   // Set when no more functions will be started
+#define Realout (Ctx->jobout)        // The whole output, as `Output` holds the current piece
+#define Workers (Ctx->workers)
+#define Nworkers (Ctx->nworkers)
+#define Joblock (Ctx->joblock)
+#define Jobready (Ctx->jobready)     // Signalled when a function can be started
+#define Jobdone (Ctx->jobdone)       // Signalled when a function is done
+
+static _Thread_local struct job *Curjob;  // A worker's current function
+static _Thread_local jmp_buf Jobabort;    // Where a worker goes after a fatal error
+static _Thread_local void (*Outerfatal)(char *msg);  // `Fatalhook` outside of `start_jobs()`
+
+// Return a copy of `n` bytes at `p`
+static void *copyof(void *p, size_t n) {
+  void *q;
+
+  if ((q = malloc(n ? n : 1)) == NULL)
+    fatal("Unable to `malloc` in `copyof()`");
+  if (n)
+    memcpy(q, p, n);
+  return q;
+}
+
+// Return a new piece of output
+static struct job *newjob(void) {
+  struct job *j;
+
+  if ((j = calloc(1, sizeof(struct job))) == NULL)
+    fatal("Unable to `malloc` in `newjob()`");
+  return j;
+}
+
+// Add a piece to the end of `Jobs[]`. Called with `Joblock` held.
+static void addjob(struct job *j) {
+  if (Njobs == Jobcap) {
+    Jobcap = Jobcap ? Jobcap * 2 : 256;
+    if ((Jobs = realloc(Jobs, Jobcap * sizeof(struct job *))) == NULL)
+      fatal("Unable to `realloc` in `addjob()`");
+  }
+
+  Jobs[Njobs++] = j;
+}
+
+// Start a new piece for the main thread's output
+static void startpiece(void) {
+  struct job *j = newjob();
+
+  useoutput(j->out = newoutput(-1));
+  pthread_mutex_lock(&Joblock);
+  addjob(j);
+  pthread_mutex_unlock(&Joblock);
+}
+
+// Finish the main thread's current piece of output
+static void endpiece(void) {
+  pthread_mutex_lock(&Joblock);
+  Jobs[Njobs - 1]->done = 1;
+  pthread_mutex_unlock(&Joblock);
+}
+
+// Add the finished pieces at the front of the list to the output.
+// If `wait` is set, wait for all of them to finish. Stop at the first
+// piece with an error and report it.
+static void writejobs(int wait) {
+  struct job *j;
+  char *msg;
+
+  pthread_mutex_lock(&Joblock);
+  while (Nwritten < Njobs) {
+    j = Jobs[Nwritten];
+    if (!j->done) {
+      if (!wait)
+        break;
+      pthread_cond_wait(&Jobdone, &Joblock);
+      continue;
+    }
+
+    if (j->error) {
+      msg = j->error;
+      j->error = NULL;
+      pthread_mutex_unlock(&Joblock);
+      Fatalhook = Outerfatal;
+      fatalmessage(msg);
+    }
+
+    // Nothing else uses the piece now, so it can be added unlocked
+    Jobs[Nwritten++] = NULL;
+    pthread_mutex_unlock(&Joblock);
+    appendoutput(Realout, j->out);
+    genflush(Realout);
+    freeoutput(j->out);
+    free(j);
+    pthread_mutex_lock(&Joblock);
+  }
+  pthread_mutex_unlock(&Joblock);
+}
+
+// A fatal error on a worker thread: keep the message with the function
+// and abandon it
+static void workerfatal(char *msg) {
+  Curjob->error = msg;
+  longjmp(Jobabort, 1);
+}
+
+// A fatal error on the main thread: keep the message with its piece, then
+// wait for the pieces before it, in case one of them has an earlier error
+static void mainfatal(char *msg) {
+  Fatalhook = Outerfatal;
+
+  pthread_mutex_lock(&Joblock);
+  Jobs[Njobs - 1]->error = msg;
+  Jobs[Njobs - 1]->done = 1;
+  Finishing = 1;
+  pthread_cond_broadcast(&Jobready);
+  pthread_mutex_unlock(&Joblock);
+
+  writejobs(1);
+  fatalmessage(msg);  // Not reached: `writejobs()` stops at this piece or before
+}
+
+// Parse and generate the code for a queued function into its piece
+static void runjob(struct job *j) {
+  int tree, *ownast;
+  struct symtable *ownlocals;
+
+  Globalsyms = j->globals;
+  Globals = j->nglobals;
+  Functionid = j->funcid;
+  Line = j->line;
+  useoutput(j->out = newoutput(-1));
+
+  if (j->ast == NULL) {
+    Tokpos = j->start;
+    scan(&Token);
+    tree = function_body(j->funcid, j->type);
+    genAST(tree, NOLABEL, 0);
+    freelocalsymbols();
+    freeASTnodes();
+  } else {
+    // Use the tree and locals that came with the function
+    ownast = ASTbuf;
+    ownlocals = Localsyms;
+    ASTbuf = j->ast;
+    Localsyms = j->locals;
+    Locals = j->nlocals;
+    genAST(j->root, NOLABEL, 0);
+    ASTbuf = ownast;
+    Localsyms = ownlocals;
+    Locals = 0;
+    free(j->ast);
+    free(j->locals);
+  }
+}
+
+// A worker thread: take the first function not yet started, until there
+// are no more. After an error its state is unknown, so it stops.
+static void *worker(void *arg) {
+  struct job *j;
+  int failed;
+
+  Ctx = arg;
+  genfreeregs();
+  Fatalhook = workerfatal;
+
+  pthread_mutex_lock(&Joblock);
+  while (1) {
+    // Pieces which have been written out have been freed
+    if (Nextjob < Nwritten)
+      Nextjob = Nwritten;
+    while (Nextjob < Njobs && (!Jobs[Nextjob]->isfunc || Jobs[Nextjob]->done))
+      Nextjob++;
+
+    // Bodies are only parsed once the symbol table is complete
+    if (Abandoned || Nextjob == Njobs || (Jobs[Nextjob]->ast == NULL && !Finishing)) {
+      if (Finishing)
+        break;
+      pthread_cond_wait(&Jobready, &Joblock);
+      continue;
+    }
+
+    // Mark the function as taken by moving past it, then work unlocked
+    j = Curjob = Jobs[Nextjob++];
+    pthread_mutex_unlock(&Joblock);
+    if ((failed = setjmp(Jobabort)) == 0)
+      runjob(j);
+    pthread_mutex_lock(&Joblock);
+    j->done = 1;
+    pthread_cond_broadcast(&Jobdone);
+    if (failed)
+      break;
+  }
+  pthread_mutex_unlock(&Joblock);
+
+  freethread();
+  return NULL;
+}
+
+// Start the worker threads. From now on the main thread's output goes
+// into pieces.
+void start_jobs(void) {
+  Nworkers = O_jobs;
+  if ((Workers = malloc(Nworkers * sizeof(pthread_t))) == NULL)
+    fatal("Unable to `malloc` in `start_jobs()`");
+
+  Realout = Output;
+  for (int i = 0; i < Nworkers; i++)
+    if (pthread_create(&Workers[i], NULL, worker, Ctx) != 0)
+      fatal("Unable to create a worker thread");
+
+  startpiece();
+  Outerfatal = Fatalhook;
+  Fatalhook = mainfatal;
+}
+
+// Add a function to the list of pieces. Its output goes between the main
+// thread's output so far and anything that follows, so carry on as if it
+// had already been output.
+static void queue(struct job *j) {
+  j->isfunc = 1;
+  j->globals = Globalsyms;
+  j->nglobals = Globals;
+  j->funcid = Functionid;
+  j->line = Line;
+
+  endpiece();
+
+  pthread_mutex_lock(&Joblock);
+  addjob(j);
+  pthread_cond_signal(&Jobready);
+  pthread_mutex_unlock(&Joblock);
+
+  startpiece();
+  writejobs(0);
+}
+
+// Queue the code generation for the function in `tree`, which has just
+// been read from an AST file. Its locals and `ASTbuf[]` can be reused
+// straight away.
+void genqueue(int tree) {
+  struct job *j = newjob();
+
+  j->ast = copyof(ASTbuf, ASTsize() * sizeof(int));
+  j->root = tree;
+  j->locals = copyof(Localsyms, Locals * sizeof(struct symtable));
+  j->nlocals = Locals;
+  queue(j);
+}
+
+// Queue the body of the function in symbol slot `id`, of type `type`, to
+// be parsed and generated. `Token` is its `{`. Skip to the token after
+// the matching `}`; if there isn't one, the worker will find the error.
+void parsequeue(int id, int type) {
+  struct job *j = newjob();
+  int depth = 0;
+
+  j->start = Tokpos - 1;
+  j->type = type;
+  Functionid = id;
+  queue(j);
+
+  for (Tokpos = j->start; Tokpos < Ntokens - 1; Tokpos++) {
+    if (Tokens[Tokpos].token == T_LBRACE)
+      depth++;
+    else if (Tokens[Tokpos].token == T_RBRACE && --depth == 0)
+      break;
+  }
+
+  if (Tokpos < Ntokens - 1)
+    Tokpos++;
+  scan(&Token);
+}
+
+// Wait for all the queued functions, write out the rest of the output and
+// stop the worker threads. The main thread's output goes to the whole
+// output again.
+void finish_jobs(void) {
+  Fatalhook = Outerfatal;
+  endpiece();
+
+  pthread_mutex_lock(&Joblock);
+  Finishing = 1;
+  pthread_cond_broadcast(&Jobready);
+  pthread_mutex_unlock(&Joblock);
+
+  writejobs(1);
+  for (int i = 0; i < Nworkers; i++)
+    pthread_join(Workers[i], NULL);
+
+  free(Workers);
+  free(Jobs);
+  Workers = NULL;
+  Jobs = NULL;
+  Njobs = Jobcap = Nextjob = Nwritten = Finishing = 0;
+  useoutput(Realout);
+}
+
+// After a fatal error has been reported from `Fatalhook`, stop the worker
+// threads once they have finished the functions they are on, and release
+// the pieces of output that weren't written. A function which was started
+// has had its tree and locals freed by its worker.
+void abandon_jobs(void) {
+  struct job *j;
+
+  if (Workers == NULL)
+    return;
+
+  pthread_mutex_lock(&Joblock);
+  Finishing = Abandoned = 1;
+  pthread_cond_broadcast(&Jobready);
+  pthread_mutex_unlock(&Joblock);
+
+  for (int i = 0; i < Nworkers; i++)
+    pthread_join(Workers[i], NULL);
+
+  for (int i = Nwritten; i < Njobs; i++) {
+    j = Jobs[i];
+    if (j->out != NULL)
+      freeoutput(j->out);
+    else {
+      free(j->ast);
+      free(j->locals);
+    }
+    free(j->error);
+    free(j);
+  }
+
+  free(Workers);
+  free(Jobs);
+  Workers = NULL;
+  Jobs = NULL;
+  Njobs = Jobcap = Nextjob = Nwritten = Finishing = Abandoned = 0;
+  useoutput(Realout);
+}
@@ -1,32 +1,250 @@
 #include "definitions.h"
-
-#define extern_
 #include "data.h"
-#undef extern_
-
 #include "declarations.h"
+#include "compiler.h"
 #include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 // Compiler set-up and top-level execution
 
-// Initialize global variables
+// Initialize global variables. The options start out clear in the context.
 static void init() {
+  if ((Ctx = newcompiler(NULL)) == NULL) {
+    fprintf(stderr, "Unable to `malloc` in `init()`\n");
+    exit(1);
+  }
   Line = 1;
-  Putback = '\n';
   Globals = 0;
-  Locals = NSYMBOLS - 1;
-  O_dumpAST = 0;
+  Locals = 0;
 }
 
 // Print instructions if program arguments are incorrect
 static void usage(char *prog) {
-  fprintf(stderr, "Usage: %s [-T] infile\n", prog);
+  fprintf(stderr, "Usage: %s [-TPALCpc] [-j[threads]] [-run] [-pipe] [-o outfile] infile...\n", prog);
   exit(1);
 }
 
+static pid_t Aspid;  // The process ID of `as` with `-pipe`, or 0
+
+// If we exit with `as` still running, after an error, stop it before it
+// writes a partial object file
+static void killassembler(void) {
+  if (Aspid > 0)
+    kill(Aspid, SIGKILL);
+}
+
+// With `-pipe`, start `as` to assemble what we write to the returned file
+// descriptor into the object file `outname`
+static int startassembler(char *outname) {
+  int fds[2];
+
+  if (pipe(fds) == -1 || (Aspid = fork()) == -1) {
+    fprintf(stderr, "Unable to start `as`: %s\n", strerror(errno));
+    exit(1);
+  }
+
+  if (Aspid == 0) {
+    dup2(fds[0], 0);
+    close(fds[0]);
+    close(fds[1]);
+    execlp("as", "as", "-o", outname, (char *)NULL);
+    fprintf(stderr, "Unable to run `as`: %s\n", strerror(errno));
+    _exit(127);
+  }
+
+  close(fds[0]);
+  atexit(killassembler);
+  return fds[1];
+}
+
+// Close the pipe to `as` and wait for it to finish. Return its exit status.
+static int finishassembler(int fd) {
+  int status;
+
+  close(fd);
+  if (waitpid(Aspid, &status, 0) == -1 || !WIFEXITED(status))
+    status = 1;
+  else
+    status = WEXITSTATUS(status);
+  Aspid = 0;
+  return status;
+}
+
+// Compile `infile` into `outname`, as set up by the options. Return the
+// exit status.
+static int compile(char *infile, char *outname) {
+  int fd = -1, status = 0;
+
+  // With `-L`, the input is an AST file written by `-A`
+  if (O_loadAST)
+    open_astfile(infile, "r");
+  else
+    open_input(infile);
+
+  // With `-A`, the parsed functions go into `out.ast` instead of `out.s`,
+  // and with `-c` the code goes into the object file `out.o`. With `-pipe`
+  // the assembly goes to `as`, which writes `out.o`. `-o` gives another
+  // name for the output, or `-` for the standard output. With `-run` the
+  // code stays in memory and is run at the end.
+  if (outname == NULL)
+    outname = O_saveAST ? "out.ast" : (O_object || O_pipe) ? "out.o" : "out.s";
+  if (O_saveAST)
+    open_astfile(outname, "w");
+  else if (O_run)
+    useoutput(newoutput(-1));
+  else if (O_pipe)
+    useoutput(newoutput(startassembler(outname)));
+  else if (!strcmp(outname, "-"))
+    useoutput(newoutput(fd = 1));
+  else if ((fd = open(outname, O_WRONLY | O_CREAT | O_TRUNC, 0666)) == -1) {
+    fprintf(stderr, "Unable to create `%s`: %s\n", outname, strerror(errno));
+    exit(1);
+  } else
+    useoutput(newoutput(fd));  // Written out by `genpostamble()`
+
+  addbuiltins();
+
+  if (O_loadAST) {
+    genpreamble();
+    if (O_jobs)
+      start_jobs();
+    loadASTfile();  // Generate the code for the saved functions
+    if (O_jobs)
+      finish_jobs();
+    genpostamble();
+  } else
+    compilesource();
+
+  if (O_saveAST || O_loadAST)
+    close_astfile();
+  if (O_run && !O_saveAST)
+    status = runobject();
+  if (O_pipe && finishassembler(Output->fd) != 0) {
+    fprintf(stderr, "`as` failed\n");
+    status = 1;
+  }
+  if (!O_saveAST) {
+    freeoutput(Output);
+    if (fd > 1)
+      close(fd);
+  }
+
+  return status;
+}
+
+// The multi-file driver.
+// With several input files, each is compiled in a child process of its
+// own, `nprocs` at a time, into a file named after it: `foo.c` becomes
+// `foo.s`, or `foo.o` with `-c` or `-pipe`, or `foo.ast` with `-A`. Here
+// an error stops the process, and the outputs are files anyway, so each
+// compile has a process rather than a context of its own (see `compiler.c`).
+// If `-o` names an executable, the outputs are then linked with
+// `lib/printint.c` by `cc`.
+
+// Return `infile` with its extension, if any, replaced by `suffix`
+static char *outputname(char *infile, char *suffix) {
+  char *base = strrchr(infile, '/'), *dot, *name;
+  int len;
+
+  base = base ? base + 1 : infile;
+  dot = strrchr(base, '.');
+  len = dot ? dot - infile : strlen(infile);
+  if ((name = malloc(len + strlen(suffix) + 1)) == NULL)
+    fatal("Unable to `malloc` in `outputname()`");
+  memcpy(name, infile, len);
+  strcpy(name + len, suffix);
+  return name;
+}
+
+// Run `argv[]` as a command and return its exit status
+static int runcommand(char **argv) {
+  pid_t pid;
+  int status;
+
+  if ((pid = fork()) == -1) {
+    fprintf(stderr, "Unable to run `%s`: %s\n", argv[0], strerror(errno));
+    return 1;
+  }
+  if (pid == 0) {
+    execvp(argv[0], argv);
+    fprintf(stderr, "Unable to run `%s`: %s\n", argv[0], strerror(errno));
+    _exit(127);
+  }
+
+  if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status))
+    return 1;
+  return WEXITSTATUS(status);
+}
+
+// Compile the `nfiles` files in `files[]`, `nprocs` at a time. If `exe` is
+// given, link them into it. `prog` is how the compiler was run, to find
+// `lib/printint.c` from. Return the exit status.
+static int drive(char **files, int nfiles, int nprocs, char *exe, char *prog) {
+  char *suffix = O_saveAST ? ".ast" : (O_object || O_pipe) ? ".o" : ".s";
+  char **outnames, **ccargv, *libsrc, *slash;
+  int i, running = 0, failed = 0, status;
+  pid_t pid;
+
+  if ((outnames = malloc(nfiles * sizeof(char *))) == NULL)
+    fatal("Unable to `malloc` in `drive()`");
+  for (i = 0; i < nfiles; i++)
+    outnames[i] = outputname(files[i], suffix);
+
+  // Start a child for each file, waiting for one to finish whenever
+  // `nprocs` are running
+  fflush(NULL);
+  for (i = 0; i < nfiles || running > 0;) {
+    if (i < nfiles && running < nprocs) {
+      if ((pid = fork()) == -1) {
+        fprintf(stderr, "Unable to start a compile: %s\n", strerror(errno));
+        exit(1);
+      }
+      if (pid == 0)
+        exit(compile(files[i], outnames[i]));
+      i++;
+      running++;
+      continue;
+    }
+
+    if (wait(&status) == -1)
+      break;
+    running--;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      failed = 1;
+  }
+  if (failed || exe == NULL)
+    return failed;
+
+  // Link everything with `lib/printint.c`, which is found next to the
+  // `bin` directory that the compiler is in
+  if ((slash = strrchr(prog, '/')) == NULL)
+    libsrc = "lib/printint.c";
+  else {
+    if ((libsrc = malloc(slash - prog + sizeof("/../lib/printint.c"))) == NULL)
+      fatal("Unable to `malloc` in `drive()`");
+    memcpy(libsrc, prog, slash - prog);
+    strcpy(libsrc + (slash - prog), "/../lib/printint.c");
+  }
+
+  if ((ccargv = malloc((nfiles + 5) * sizeof(char *))) == NULL)
+    fatal("Unable to `malloc` in `drive()`");
+  ccargv[0] = "cc";
+  ccargv[1] = "-o";
+  ccargv[2] = exe;
+  for (i = 0; i < nfiles; i++)
+    ccargv[3 + i] = outnames[i];
+  ccargv[3 + nfiles] = libsrc;
+  ccargv[4 + nfiles] = NULL;
+  return runcommand(ccargv) != 0;
+}
+
 // Open/scan the file and its tokens
 int main(int argc, char *argv[]) {
-  int i;
+  int i, nprocs;
+  char *outname = NULL;
 
   init();  // Initialize globals
 
@@ -34,42 +252,89 @@ int main(int argc, char *argv[]) {
   for (i = 1; i < argc; i++) {
     if (*argv[i] != '-') break;
 
+    // Options which are words rather than single letters
+    if (!strcmp(argv[i], "-run")) {
+      O_run = 1;
+      continue;
+    }
+    if (!strcmp(argv[i], "-pipe")) {
+      O_pipe = 1;
+      continue;
+    }
+    if (!strcmp(argv[i], "-o")) {
+      if (++i == argc)
+        usage(argv[0]);
+      outname = argv[i];
+      continue;
+    }
+
     for (int j = 1; argv[i][j]; j++) {
       switch (argv[i][j]) {
         case 'T':
           O_dumpAST = 1;
           break;
+        case 'P':
+          O_pretokenize = 1;
+          break;
+        case 'A':
+          O_saveAST = 1;
+          break;
+        case 'L':
+          O_loadAST = 1;
+          break;
+        case 'C':
+          O_cache = 1;
+          break;
+        case 'p':
+          O_pipeline = 1;
+          break;
+        case 'c':
+          O_object = 1;
+          break;
+        case 'j':
+          // The rest of the argument is the number of threads, if given
+          if (argv[i][j + 1])
+            O_jobs = atoi(&argv[i][j + 1]);
+          else
+            O_jobs = sysconf(_SC_NPROCESSORS_ONLN);
+          while (argv[i][j + 1])
+            j++;
+          break;
         default:
           usage(argv[0]);
       }
     }
   }
 
-  // Ensure we have an input file argument
-  if (i >= argc)
+  // Ensure we have an input file argument, and at most one of `-A`, `-L`
+  // and `-C`. With several input files, `-j` is how many are compiled at
+  // once, and each is compiled on one thread; they can't be run, or linked
+  // from AST files. Otherwise functions are only done on other threads with
+  // `-j` when there is more than one, and not with `-A`, `-C` or `-T`.
+  if (i >= argc || O_saveAST + O_loadAST + O_cache > 1)
     usage(argv[0]);
-
-  if ((Infile = fopen(argv[i], "r")) == NULL) {
-    fprintf(stderr, "Unable to open %s: %s\n", argv[i], strerror(errno));
-    exit(1);
+  if (argc - i > 1) {
+    if (O_run || (O_saveAST && outname))
+      usage(argv[0]);
+    nprocs = O_jobs ? O_jobs : sysconf(_SC_NPROCESSORS_ONLN);
+    O_jobs = 0;
   }
+  if (O_jobs < 2 || O_saveAST || O_cache || O_dumpAST)
+    O_jobs = 0;
 
-  if ((Outfile = fopen("out.s", "w")) == NULL) {
-    fprintf(stderr, "Unable to create `out.s`: %s\n", strerror(errno));
-    exit(1);
-  }
-
-  // For now, ensure that `void printint()` is defined
-  addglobal("printint", P_INT, S_FUNCTION, C_GLOBAL, 0, 0);
-  addglobal("printchar", P_VOID, S_FUNCTION, C_GLOBAL, 0, 0);
-
-  scan(&Token);  // Get the first token from the input
-  genpreamble();
-  global_declarations();  // Parse the global declarations
-  genpostamble();
+  // With `-p`, the input is lexed on one thread, parsed on this one and
+  // the code is generated on the worker threads, one unless `-j` says
+  // otherwise. This is only for source input which isn't tokenized first.
+  if (O_pretokenize || O_cache || O_saveAST || O_loadAST)
+    O_pipeline = 0;
+  if (O_pipeline && O_jobs == 0)
+    O_jobs = 1;
 
-  fclose(Infile);
-  fclose(Outfile);
+  // `-pipe` is only for assembly output
+  if (O_object || O_run || O_saveAST)
+    O_pipe = 0;
 
-  return 0;
+  if (argc - i == 1)
+    return compile(argv[i], outname);
+  return drive(argv + i, argc - i, nprocs, outname, argv[0]);
 }
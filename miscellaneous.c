@@ -1,6 +1,7 @@
 #include "definitions.h"
 #include "data.h"
 #include "declarations.h"
+#include <stdarg.h>
 
 // Miscellaneous functions
 
@@ -42,22 +43,52 @@ void ident(void) {
   match(T_IDENT, "identifier");
 }
 
-void fatal(char *s) {
-  fprintf(stderr, "%s on line %d\n", s, Line);
+// Print a fatal error message and stop. While functions are being parsed on
+// worker threads (see `jobs.c`), the message goes to `Fatalhook()` instead
+// so that only the first error in the source is printed. When compiling
+// into memory, it ends the compilation instead (see `compiler.c`).
+static void fatalmsg(char *fmt, ...) {
+  va_list ap, ap2;
+  char *msg;
+  int len;
+
+  va_start(ap, fmt);
+  if (Fatalhook) {
+    va_copy(ap2, ap);
+    len = vsnprintf(NULL, 0, fmt, ap2);
+    va_end(ap2);
+    if ((msg = malloc(len + 1)) != NULL) {
+      vsnprintf(msg, len + 1, fmt, ap);
+      Fatalhook(msg);  // Doesn't return
+    }
+  }
+
+  vfprintf(stderr, fmt, ap);
+  va_end(ap);
   exit(1);
 }
 
-void fatals(char *s1, char *s2) {
-  fprintf(stderr, "%s: %s on line %d\n", s1, s2, Line);
+// Report a fatal error whose message was made on another thread
+void fatalmessage(char *msg) {
+  if (Fatalhook)
+    Fatalhook(msg);  // Doesn't return
+
+  fputs(msg, stderr);
   exit(1);
 }
 
+void fatal(char *s) {
+  fatalmsg("%s on line %d\n", s, Line);
+}
+
+void fatals(char *s1, char *s2) {
+  fatalmsg("%s: %s on line %d\n", s1, s2, Line);
+}
+
 void fatald(char *s, int d) {
-  fprintf(stderr, "%s: %d on line %d\n", s, d, Line);
-  exit(1);
+  fatalmsg("%s: %d on line %d\n", s, d, Line);
 }
 
 void fatalc(char *s, int c) {
-  fprintf(stderr, "%s: %c on line %d\n", s, c, Line);
-  exit(1);
+  fatalmsg("%s: %c on line %d\n", s, c, Line);
 }
@@ -0,0 +1,978 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <elf.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ELF object file output and in-memory execution for x86-64.
+// With `-c`, the sections which the x86-64 backend has generated are
+// encoded here into machine code and written as an ELF64 relocatable
+// object, `out.o`, instead of being written as assembly for `as`. The
+// backend only ever uses a small set of instructions and operand forms,
+// and its output is in a fixed layout, so each line can be encoded as it
+// is read, without a general assembler's parsing.
+//
+// Branches and calls are always given 32-bit displacements. Those to
+// labels in `.text` are filled in once the section is done; the rest, and
+// all `%rip`-relative operands, become relocations. References to local
+// labels (`.L...`) are made relative to their section's symbol, and local
+// labels don't go in the symbol table.
+//
+// With `-run`, the encoded sections are loaded into memory instead, every
+// reference is filled in, and the program's `main()` is called in this
+// process. `printint()` and `printchar()` are the compiler's own.
+
+// An operand of an instruction
+struct operand {
+  int kind;    // One of the `O_XXX` values below
+  int reg;     // Register, or the base register of a memory operand (`RIP` for `%rip`)
+  int size;    // Size of a register in bytes
+  long value;  // An immediate value, or the displacement of a memory operand
+  int sym;     // Symbol of a jump target or a `%rip`-relative operand
+};
+
+enum {
+  O_REG,  // %reg
+  O_IMM,  // $value
+  O_MEM,  // value(%reg) or symbol(%rip)
+  O_SYM   // symbol
+};
+
+#define RIP -1
+
+// A symbol: a label, a function or a global variable
+struct objsym {
+  char *name;  // Interned name
+  int sec;     // `SEC_XXX` section it's defined in, or -1
+  long value;  // Offset in the section
+  long size;   // From `.size`
+  int global;  // True once it's named by `.globl`
+  int type;    // `STT_XXX` type, from `.type`
+  int index;   // Position in the ELF symbol table
+};
+
+// A place in `.text` which refers to a symbol, to be filled in at the end
+struct fixup {
+  long offset;  // Offset of the 32-bit field
+  int sym;      // The symbol
+  int call;     // True for a call, which may go to another object file
+};
+
+// The encoding is done on the compilation's main thread, so its state is
+// per thread like the code generator's
+static _Thread_local struct objsym *Syms;    // The symbols
+static _Thread_local int Nsyms;              // Number of symbols
+static _Thread_local int Symcap;             // Capacity of `Syms[]`
+static _Thread_local int *Symbyname;         // For each name id, its symbol + 1
+static _Thread_local int Symbynamecap;       // Capacity of `Symbyname[]`
+static _Thread_local struct fixup *Fixups;   // References to be filled in
+static _Thread_local int Nfixups;            // Number of fixups
+static _Thread_local int Fixupcap;           // Capacity of `Fixups[]`
+static _Thread_local struct output *Obj;     // The encoded contents of each section
+static _Thread_local long Bsssize;           // The size of `.bss`, which has no contents
+static _Thread_local long Align[NSECTIONS];  // The alignment of each section
+static _Thread_local struct outbuf *Code;    // The contents of the section being encoded
+static _Thread_local int Cursec;             // and which one it is
+static _Thread_local char *Curline;          // The line being encoded, for error messages
+
+// The ELF section header table. Each output section's index is one more
+// than its `SEC_XXX` value.
+enum {
+  SH_NULL,
+  SH_TEXT,
+  SH_DATA,
+  SH_RODATA,
+  SH_BSS,
+  SH_RELATEXT,
+  SH_SYMTAB,
+  SH_STRTAB,
+  SH_SHSTRTAB,
+  SH_NOTESTACK,
+  NSHDRS
+};
+
+// Section names, in `SH_XXX` order, as they go in `.shstrtab`
+static char *Shnames[NSHDRS] = {
+    "", ".text", ".data", ".rodata", ".bss", ".rela.text",
+    ".symtab", ".strtab", ".shstrtab", ".note.GNU-stack"};
+
+// Report an error in the assembly being encoded
+static void objerror(char *msg) {
+  char *end = strchr(Curline, '\n');
+
+  if (end)
+    *end = '\0';
+  fatals(msg, Curline);
+}
+
+// Return the symbol with the `len` characters at `name`, adding it if it's new
+static int findsym(char *name, int len) {
+  int id = internid(name, len, strhash(name, len));
+
+  if (id >= Symbynamecap) {
+    int oldcap = Symbynamecap;
+    Symbynamecap = Nnames * 2;
+    if ((Symbyname = realloc(Symbyname, Symbynamecap * sizeof(int))) == NULL)
+      fatal("Unable to `realloc` in `findsym()`");
+    memset(Symbyname + oldcap, 0, (Symbynamecap - oldcap) * sizeof(int));
+  }
+
+  if (Symbyname[id] == 0) {
+    if (Nsyms == Symcap) {
+      Symcap = Symcap ? Symcap * 2 : 1024;
+      if ((Syms = realloc(Syms, Symcap * sizeof(struct objsym))) == NULL)
+        fatal("Unable to `realloc` in `findsym()`");
+    }
+    Syms[Nsyms].name = Names[id];
+    Syms[Nsyms].sec = -1;
+    Syms[Nsyms].value = Syms[Nsyms].size = 0;
+    Syms[Nsyms].global = 0;
+    Syms[Nsyms].type = STT_NOTYPE;
+    Symbyname[id] = ++Nsyms;
+  }
+
+  return Symbyname[id] - 1;
+}
+
+// Return true if the symbol is a local label, which stays out of the symbol table
+static int islocal(int sym) {
+  return Syms[sym].name[0] == '.' && Syms[sym].name[1] == 'L';
+}
+
+// Add a fixup for the 32-bit field about to be output
+static void addfixup(int sym, int call) {
+  if (Nfixups == Fixupcap) {
+    Fixupcap = Fixupcap ? Fixupcap * 2 : 1024;
+    if ((Fixups = realloc(Fixups, Fixupcap * sizeof(struct fixup))) == NULL)
+      fatal("Unable to `realloc` in `addfixup()`");
+  }
+
+  Fixups[Nfixups].offset = Code->len;
+  Fixups[Nfixups].sym = sym;
+  Fixups[Nfixups++].call = call;
+}
+
+// Output a byte of machine code
+static void byte(int b) {
+  char c = b;
+  outwrite(Code, &c, 1);
+}
+
+// Output a 32-bit little-endian value
+static void dword(long v) {
+  char b[4] = {v, v >> 8, v >> 16, v >> 24};
+  outwrite(Code, b, 4);
+}
+
+// Return the length of the symbol name at `p`
+static int symlen(char *p) {
+  int len = 0;
+
+  while (p[len] && !strchr(",():\n\t ", p[len]))
+    len++;
+  return len;
+}
+
+// The two-letter names of the first eight registers, in number order
+static char Regnames[] = "axcxdxbxspbpsidi";
+
+// Parse the register name at `p`, after its `%`, into `o`. Return the
+// characters after it.
+static char *parsereg(char *p, struct operand *o) {
+  int i;
+
+  o->kind = O_REG;
+
+  // `%r8` to `%r15`, with a `b` or `d` for the byte and 32-bit registers
+  if (p[0] == 'r' && isdigit(p[1])) {
+    o->reg = strtol(p + 1, &p, 10);
+    o->size = (*p == 'b') ? 1 : (*p == 'd') ? 4 : 8;
+    if (*p == 'b' || *p == 'd')
+      p++;
+    return p;
+  }
+
+  // `%rax` and `%eax` and the like
+  if (p[0] == 'r' || p[0] == 'e') {
+    for (i = 0; i < 8; i++)
+      if (p[1] == Regnames[2 * i] && p[2] == Regnames[2 * i + 1]) {
+        o->reg = i;
+        o->size = (p[0] == 'r') ? 8 : 4;
+        return p + 3;
+      }
+  }
+
+  // The byte registers `%al`, `%cl`, `%dl`, `%bl`, `%spl`, `%bpl`, `%sil` and `%dil`
+  for (i = 0; i < 8; i++) {
+    if (i < 4 && p[0] == Regnames[2 * i] && p[1] == 'l') {
+      o->reg = i;
+      o->size = 1;
+      return p + 2;
+    }
+    if (i >= 4 && p[0] == Regnames[2 * i] && p[1] == Regnames[2 * i + 1] && p[2] == 'l') {
+      o->reg = i;
+      o->size = 1;
+      return p + 3;
+    }
+  }
+
+  objerror("Unknown register in");
+  return p;
+}
+
+// Parse the operand at `p` into `o`. Return the characters after it.
+static char *parseoperand(char *p, struct operand *o) {
+  int len;
+
+  while (*p == ' ')
+    p++;
+
+  if (*p == '%')
+    return parsereg(p + 1, o);
+
+  if (*p == '$') {
+    o->kind = O_IMM;
+    o->value = strtol(p + 1, &p, 10);
+    return p;
+  }
+
+  // A displacement, or a symbol, then maybe a base register in brackets
+  o->value = 0;
+  o->sym = -1;
+  if (*p == '-' || isdigit(*p))
+    o->value = strtol(p, &p, 10);
+  else if (*p != '(') {
+    len = symlen(p);
+    o->sym = findsym(p, len);
+    p += len;
+  }
+
+  if (*p != '(') {
+    o->kind = O_SYM;
+    return p;
+  }
+
+  if (!strncmp(p, "(%rip)", 6)) {
+    o->kind = O_MEM;
+    o->reg = RIP;
+    return p + 6;
+  }
+  p = parsereg(p + 2, o);
+  o->kind = O_MEM;
+  if (*p != ')')
+    objerror("Bad memory operand in");
+  return p + 1;
+}
+
+// Return true if the register or memory operand needs a REX prefix
+// whatever its other bits. The byte registers `%spl`, `%bpl`, `%sil` and
+// `%dil` can only be named with one.
+static int needsrex(struct operand *o) {
+  return o->kind == O_REG && o->size == 1 && o->reg >= 4 && o->reg < 8;
+}
+
+// Encode an instruction with the `n` opcode bytes in `op`, whose ModRM
+// byte has the register or opcode extension `reg` and the register or
+// memory operand `rm`. `w` is set for a 64-bit operation, and `regop` is
+// the register operand that `reg` came from, if any.
+static void encode(int w, char *op, int n, int reg, struct operand *regop, struct operand *rm) {
+  int rex = 0x40 | (w ? 8 : 0) | ((reg & 8) ? 4 : 0);
+  int base = rm->reg, mod;
+
+  if (!(rm->kind == O_MEM && base == RIP) && (base & 8))
+    rex |= 1;
+  if (rex != 0x40 || needsrex(rm) || (regop && needsrex(regop)))
+    byte(rex);
+  outwrite(Code, op, n);
+
+  // A register
+  if (rm->kind == O_REG) {
+    byte(0xc0 | (reg & 7) << 3 | (base & 7));
+    return;
+  }
+
+  // A symbol relative to the next instruction
+  if (base == RIP) {
+    byte((reg & 7) << 3 | 5);
+    addfixup(rm->sym, 0);
+    dword(0);
+    return;
+  }
+
+  // A base register and a displacement. `%rbp` and `%r13` always need a
+  // displacement, and `%rsp` and `%r12` need a SIB byte.
+  if (rm->value == 0 && (base & 7) != 5)
+    mod = 0;
+  else if (rm->value >= -128 && rm->value <= 127)
+    mod = 1;
+  else
+    mod = 2;
+  byte(mod << 6 | (reg & 7) << 3 | (base & 7));
+  if ((base & 7) == 4)
+    byte(0x24);
+  if (mod == 1)
+    byte(rm->value);
+  else if (mod == 2)
+    dword(rm->value);
+}
+
+// Instruction forms
+enum {
+  F_FIXED,   // Fixed bytes: `ret`, `cqo`
+  F_MOV,     // mov: register or immediate to register or memory, or memory to register
+  F_ALU,     // add, sub, and, or, xor, cmp: register to register or memory, or immediate
+  F_LOAD,    // movzb, movslq, leaq, imulq, test: register or memory to a register
+  F_UNARY,   // The opcode with extension `ext` on a register or memory
+  F_SHIFT,   // shl/shr/sal by `%cl` or an immediate
+  F_SETCC,   // setcc on a byte register
+  F_BRANCH,  // jmp, jcc and call to a symbol
+  F_PUSH     // push and pop of a register
+};
+
+struct insn {
+  char *name;
+  int form;
+  int w;             // Set for a 64-bit operation
+  char op[3];        // The opcode bytes
+  int oplen;         // and how many there are
+  int ext;           // Opcode extension, or the immediate form's opcode for `F_ALU`
+};
+
+static struct insn Insns[] = {
+    {"movq", F_MOV, 1, {0x89}, 1, 0},
+    {"movslq", F_LOAD, 1, {0x63}, 1, 0},
+    {"movl", F_MOV, 0, {0x89}, 1, 0},
+    {"addq", F_ALU, 1, {0x01}, 1, 0},
+    {"jmp", F_BRANCH, 0, {0xe9}, 1, 0},
+    {"movzbq", F_LOAD, 1, {0x0f, 0xb6}, 2, 0},
+    {"movb", F_MOV, 0, {0x88}, 1, 0},
+    {"subq", F_ALU, 1, {0x29}, 1, 5},
+    {"cmpq", F_ALU, 1, {0x39}, 1, 7},
+    {"leaq", F_LOAD, 1, {0x8d}, 1, 0},
+    {"imulq", F_LOAD, 1, {0x0f, 0xaf}, 2, 0},
+    {"test", F_LOAD, 1, {0x85}, 1, 0},
+    {"call", F_BRANCH, 0, {0xe8}, 1, 0},
+    {"je", F_BRANCH, 0, {0x0f, 0x84}, 2, 0},
+    {"jne", F_BRANCH, 0, {0x0f, 0x85}, 2, 0},
+    {"jl", F_BRANCH, 0, {0x0f, 0x8c}, 2, 0},
+    {"jge", F_BRANCH, 0, {0x0f, 0x8d}, 2, 0},
+    {"jle", F_BRANCH, 0, {0x0f, 0x8e}, 2, 0},
+    {"jg", F_BRANCH, 0, {0x0f, 0x8f}, 2, 0},
+    {"pushq", F_PUSH, 0, {0x50}, 1, 0},
+    {"popq", F_PUSH, 0, {0x58}, 1, 0},
+    {"ret", F_FIXED, 0, {0xc3}, 1, 0},
+    {"cqo", F_FIXED, 0, {0x48, 0x99}, 2, 0},
+    {"movzbl", F_LOAD, 0, {0x0f, 0xb6}, 2, 0},
+    {"andq", F_ALU, 1, {0x21}, 1, 4},
+    {"orq", F_ALU, 1, {0x09}, 1, 1},
+    {"xorq", F_ALU, 1, {0x31}, 1, 6},
+    {"idivq", F_UNARY, 1, {0xf7}, 1, 7},
+    {"negq", F_UNARY, 1, {0xf7}, 1, 3},
+    {"notq", F_UNARY, 1, {0xf7}, 1, 2},
+    {"incb", F_UNARY, 0, {0xfe}, 1, 0},
+    {"decb", F_UNARY, 0, {0xfe}, 1, 1},
+    {"incl", F_UNARY, 0, {0xff}, 1, 0},
+    {"decl", F_UNARY, 0, {0xff}, 1, 1},
+    {"incq", F_UNARY, 1, {0xff}, 1, 0},
+    {"decq", F_UNARY, 1, {0xff}, 1, 1},
+    {"shlq", F_SHIFT, 1, {0xd3}, 1, 4},
+    {"salq", F_SHIFT, 1, {0xd3}, 1, 4},
+    {"shrq", F_SHIFT, 1, {0xd3}, 1, 5},
+    {"sete", F_SETCC, 0, {0x0f, 0x94}, 2, 0},
+    {"setne", F_SETCC, 0, {0x0f, 0x95}, 2, 0},
+    {"setnz", F_SETCC, 0, {0x0f, 0x95}, 2, 0},
+    {"setl", F_SETCC, 0, {0x0f, 0x9c}, 2, 0},
+    {"setge", F_SETCC, 0, {0x0f, 0x9d}, 2, 0},
+    {"setle", F_SETCC, 0, {0x0f, 0x9e}, 2, 0},
+    {"setg", F_SETCC, 0, {0x0f, 0x9f}, 2, 0},
+    {NULL}};
+
+// Encode the instruction `in`, whose operands are at `p`
+static void encodeinsn(struct insn *in, char *p) {
+  struct operand a, b;
+  int nops = 0;
+  char c;
+
+  if (*p == '\t') {
+    p = parseoperand(p + 1, &a);
+    nops = 1;
+    if (*p == ',') {
+      p = parseoperand(p + 1, &b);
+      nops = 2;
+    }
+  }
+  if (*p != '\n')
+    objerror("Can't encode");
+
+  switch (in->form) {
+    case F_FIXED:
+      outwrite(Code, in->op, in->oplen);
+      return;
+
+    case F_MOV:
+      if (nops != 2 || b.kind == O_IMM || b.kind == O_SYM || (a.kind == O_MEM && b.kind == O_MEM))
+        break;
+      if (a.kind == O_IMM) {
+        // movq $imm32, %reg
+        c = 0xc7;
+        encode(in->w, &c, 1, 0, NULL, &b);
+        dword(a.value);
+      } else if (a.kind == O_MEM) {
+        c = in->op[0] + 2;  // The load form of the opcode
+        encode(in->w, &c, 1, b.reg, &b, &a);
+      } else
+        encode(in->w, in->op, 1, a.reg, &a, &b);
+      return;
+
+    case F_ALU:
+      if (nops != 2 || b.kind == O_IMM || b.kind == O_SYM)
+        break;
+      if (a.kind == O_IMM) {
+        c = (a.value >= -128 && a.value <= 127) ? 0x83 : 0x81;
+        encode(in->w, &c, 1, in->ext, NULL, &b);
+        if (a.value >= -128 && a.value <= 127)
+          byte(a.value);
+        else
+          dword(a.value);
+      } else if (a.kind == O_REG)
+        encode(in->w, in->op, 1, a.reg, &a, &b);
+      else
+        break;
+      return;
+
+    case F_LOAD:
+      if (nops != 2 || b.kind != O_REG || (a.kind != O_REG && a.kind != O_MEM))
+        break;
+      encode(in->w, in->op, in->oplen, b.reg, &b, &a);
+      return;
+
+    case F_UNARY:
+      if (nops != 1 || (a.kind != O_REG && a.kind != O_MEM))
+        break;
+      encode(in->w, in->op, 1, in->ext, NULL, &a);
+      return;
+
+    case F_SHIFT:
+      if (nops != 2 || b.kind != O_REG)
+        break;
+      if (a.kind == O_IMM) {
+        c = 0xc1;
+        encode(in->w, &c, 1, in->ext, NULL, &b);
+        byte(a.value);
+      } else
+        encode(in->w, in->op, 1, in->ext, NULL, &b);
+      return;
+
+    case F_SETCC:
+      if (nops != 1 || a.kind != O_REG)
+        break;
+      encode(0, in->op, 2, 0, NULL, &a);
+      return;
+
+    case F_BRANCH:
+      if (nops != 1 || a.kind != O_SYM)
+        break;
+      outwrite(Code, in->op, in->oplen);
+      addfixup(a.sym, in->op[0] == (char)0xe8);
+      dword(0);
+      return;
+
+    case F_PUSH:
+      if (nops != 1 || a.kind != O_REG)
+        break;
+      if (a.reg & 8)
+        byte(0x41);
+      byte(in->op[0] + (a.reg & 7));
+      return;
+  }
+
+  objerror("Can't encode");
+}
+
+// Return the number after the directive or symbol name at `p`
+static long number(char *p) {
+  while (*p == ' ' || *p == ',')
+    p++;
+  return strtol(p, NULL, 10);
+}
+
+// Output the characters of a `.ascii` or `.string` directive at `p`,
+// which start with a `"`. Only octal escapes are used.
+static void strchars(char *p) {
+  for (p++; *p != '"'; p++) {
+    if (*p == '\\') {
+      byte((p[1] - '0') << 6 | (p[2] - '0') << 3 | (p[3] - '0'));
+      p += 3;
+    } else
+      byte(*p);
+  }
+}
+
+// Pad the section being encoded to a multiple of `n` bytes
+static void align(long n) {
+  if (n > Align[Cursec])
+    Align[Cursec] = n;
+
+  if (Cursec == SEC_BSS)
+    Bsssize = (Bsssize + n - 1) / n * n;
+  else
+    while (Code->len % n)
+      byte(Cursec == SEC_TEXT ? 0x90 : 0);
+}
+
+// Encode a directive, whose name `name` has `len` characters, with the
+// arguments at `p`
+static void directive(char *name, int len, char *p) {
+  int sym;
+
+  if (len == 6 && !strncmp(name, ".globl", len)) {
+    sym = findsym(p, symlen(p));
+    Syms[sym].global = 1;
+  } else if (len == 5 && !strncmp(name, ".type", len)) {
+    sym = findsym(p, symlen(p));
+    Syms[sym].type = strstr(p, "@function") ? STT_FUNC : STT_OBJECT;
+  } else if (len == 5 && !strncmp(name, ".size", len)) {
+    sym = findsym(p, symlen(p));
+    Syms[sym].size = number(p + symlen(p));
+  } else if (len == 6 && !strncmp(name, ".align", len)) {
+    align(number(p));
+  } else if (len == 5 && !strncmp(name, ".zero", len)) {
+    if (Cursec == SEC_BSS)
+      Bsssize += number(p);
+    else
+      for (long n = number(p); n > 0; n--)
+        byte(0);
+  } else if (len == 6 && !strncmp(name, ".ascii", len)) {
+    strchars(p);
+  } else if (len == 7 && !strncmp(name, ".string", len)) {
+    strchars(p);
+    byte(0);
+  } else
+    objerror("Unknown directive");
+}
+
+// Encode one section's assembly, from `Output`, into `Obj`
+static void encodesection(int sec) {
+  struct outbuf *text = Output->sec[sec];
+  char *p, *end, *name;
+  struct insn *in;
+  int len, sym;
+
+  Cursec = sec;
+  Code = Obj->sec[sec];
+  outwrite(text, "", 1);  // NUL-terminate it, for `strtol()` and the like
+  for (p = text->buf, end = p + text->len - 1; p < end; p = strchr(p, '\n') + 1) {
+    Curline = p;
+
+    // A label
+    if (*p != '\t') {
+      sym = findsym(p, symlen(p));
+      if (Syms[sym].sec != -1)
+        objerror("Label defined twice");
+      Syms[sym].sec = sec;
+      Syms[sym].value = (sec == SEC_BSS) ? Bsssize : Code->len;
+      continue;
+    }
+
+    name = ++p;
+    for (len = 0; name[len] != '\t' && name[len] != '\n'; len++)
+      ;
+    p += len;
+
+    if (*name == '.') {
+      directive(name, len, (*p == '\t') ? p + 1 : p);
+      continue;
+    }
+
+    for (in = Insns; in->name; in++)
+      if (!strncmp(in->name, name, len) && in->name[len] == '\0')
+        break;
+    if (in->name == NULL)
+      objerror("Unknown instruction");
+    encodeinsn(in, p);
+  }
+}
+
+// Write a 32-bit value into the code at `code`, at `offset`
+static void patch(char *code, long offset, long v) {
+  char *p = code + offset;
+
+  p[0] = v;
+  p[1] = v >> 8;
+  p[2] = v >> 16;
+  p[3] = v >> 24;
+}
+
+// Return the offset of the end of `o`, padded to a multiple of `n`
+static long pad(struct outbuf *o, long n) {
+  while (o->len % n)
+    outwrite(o, "", 1);
+  return o->len;
+}
+
+// Encode each section in `Output` into `Obj`
+static void encodeall(void) {
+  Obj = newoutput(-1);
+  for (int i = 0; i < NSECTIONS; i++) {
+    Align[i] = (i == SEC_TEXT) ? 16 : 1;
+    encodesection(i);
+  }
+}
+
+// Release the encoded sections and the symbols
+static void freeencoding(void) {
+  freeoutput(Obj);
+  free(Syms);
+  free(Symbyname);
+  free(Fixups);
+  Obj = NULL;
+  Syms = NULL;
+  Symbyname = NULL;
+  Fixups = NULL;
+  Nsyms = Symcap = Symbynamecap = Nfixups = Fixupcap = 0;
+  Bsssize = 0;
+}
+
+// Encode the sections in `Output` and write them to its file as an ELF
+// relocatable object, or its buffer
+void writeobject(void) {
+  Elf64_Ehdr *eh;
+  Elf64_Shdr sh[NSHDRS];
+  Elf64_Sym es;
+  Elf64_Rela rel;
+  struct outbuf *file, *symtab, *strtab, *rela, *shstrtab;
+  struct fixup *f;
+  struct objsym *s;
+  long offset[NSHDRS];
+  int i, nlocal, sec;
+
+  encodeall();
+
+  // The symbol table: the null symbol, one for each section and the local
+  // symbols, then the global ones. Names which aren't defined here are
+  // global, and come from another object file.
+  symtab = newoutbuf();
+  strtab = newoutbuf();
+  outwrite(strtab, "", 1);
+  memset(&es, 0, sizeof(es));
+  outwrite(symtab, (char *)&es, sizeof(es));
+  for (sec = 0; sec < NSECTIONS; sec++) {
+    es.st_info = ELF64_ST_INFO(STB_LOCAL, STT_SECTION);
+    es.st_shndx = 1 + sec;
+    outwrite(symtab, (char *)&es, sizeof(es));
+  }
+  for (i = 0; i < Nsyms; i++)
+    if (Syms[i].sec == -1 && !islocal(i))
+      Syms[i].global = 1;
+  nlocal = 0;
+  for (int global = 0; global < 2; global++) {
+    if (global)
+      nlocal = symtab->len / sizeof(es);
+    for (i = 0; i < Nsyms; i++) {
+      s = &Syms[i];
+      if (islocal(i) || s->global != global)
+        continue;
+      s->index = symtab->len / sizeof(es);
+      es.st_name = strtab->len;
+      es.st_info = ELF64_ST_INFO(global ? STB_GLOBAL : STB_LOCAL, s->type);
+      es.st_other = STV_DEFAULT;
+      es.st_shndx = (s->sec == -1) ? SHN_UNDEF : 1 + s->sec;
+      es.st_value = s->value;
+      es.st_size = s->size;
+      outwrite(symtab, (char *)&es, sizeof(es));
+      outwrite(strtab, s->name, strlen(s->name) + 1);
+    }
+  }
+
+  // Go through the references to symbols. Those in `.text` can be filled
+  // in now, and the rest are relocated. Local labels are found from their
+  // section's symbol.
+  rela = newoutbuf();
+  for (i = 0; i < Nfixups; i++) {
+    f = &Fixups[i];
+    s = &Syms[f->sym];
+    if (s->sec == SEC_TEXT) {
+      patch(Obj->sec[SEC_TEXT]->buf, f->offset, s->value - (f->offset + 4));
+      continue;
+    }
+    if (s->sec == -1 && islocal(f->sym)) {
+      Curline = s->name;
+      objerror("Undefined label");
+    }
+
+    rel.r_offset = f->offset;
+    rel.r_addend = -4;
+    if (islocal(f->sym)) {
+      rel.r_info = ELF64_R_INFO(1 + s->sec, R_X86_64_PC32);
+      rel.r_addend += s->value;
+    } else
+      rel.r_info = ELF64_R_INFO(s->index, f->call ? R_X86_64_PLT32 : R_X86_64_PC32);
+    outwrite(rela, (char *)&rel, sizeof(rel));
+  }
+
+  shstrtab = newoutbuf();
+  for (i = 0; i < NSHDRS; i++) {
+    memset(&sh[i], 0, sizeof(Elf64_Shdr));
+    sh[i].sh_name = shstrtab->len;
+    outwrite(shstrtab, Shnames[i], strlen(Shnames[i]) + 1);
+  }
+
+  // Lay out the file: the ELF header, the contents of the sections, and
+  // the section header table
+  file = newoutbuf();
+  file->len = sizeof(Elf64_Ehdr);  // Filled in at the end
+  for (sec = 0; sec < NSECTIONS; sec++) {
+    offset[1 + sec] = pad(file, Align[sec]);
+    outwrite(file, Obj->sec[sec]->buf, Obj->sec[sec]->len);
+  }
+  offset[SH_RELATEXT] = pad(file, 8);
+  outwrite(file, rela->buf, rela->len);
+  offset[SH_SYMTAB] = pad(file, 8);
+  outwrite(file, symtab->buf, symtab->len);
+  offset[SH_STRTAB] = file->len;
+  outwrite(file, strtab->buf, strtab->len);
+  offset[SH_SHSTRTAB] = file->len;
+  outwrite(file, shstrtab->buf, shstrtab->len);
+  offset[SH_NOTESTACK] = file->len;
+
+  for (sec = 0; sec < NSECTIONS; sec++) {
+    sh[1 + sec].sh_type = (sec == SEC_BSS) ? SHT_NOBITS : SHT_PROGBITS;
+    sh[1 + sec].sh_offset = offset[1 + sec];
+    sh[1 + sec].sh_size = (sec == SEC_BSS) ? Bsssize : Obj->sec[sec]->len;
+    sh[1 + sec].sh_addralign = Align[sec];
+  }
+  sh[SH_TEXT].sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+  sh[SH_DATA].sh_flags = SHF_ALLOC | SHF_WRITE;
+  sh[SH_RODATA].sh_flags = SHF_ALLOC;
+  sh[SH_BSS].sh_flags = SHF_ALLOC | SHF_WRITE;
+
+  sh[SH_RELATEXT].sh_type = SHT_RELA;
+  sh[SH_RELATEXT].sh_flags = SHF_INFO_LINK;
+  sh[SH_RELATEXT].sh_offset = offset[SH_RELATEXT];
+  sh[SH_RELATEXT].sh_size = rela->len;
+  sh[SH_RELATEXT].sh_link = SH_SYMTAB;
+  sh[SH_RELATEXT].sh_info = SH_TEXT;
+  sh[SH_RELATEXT].sh_addralign = 8;
+  sh[SH_RELATEXT].sh_entsize = sizeof(Elf64_Rela);
+
+  sh[SH_SYMTAB].sh_type = SHT_SYMTAB;
+  sh[SH_SYMTAB].sh_offset = offset[SH_SYMTAB];
+  sh[SH_SYMTAB].sh_size = symtab->len;
+  sh[SH_SYMTAB].sh_link = SH_STRTAB;
+  sh[SH_SYMTAB].sh_info = nlocal;
+  sh[SH_SYMTAB].sh_addralign = 8;
+  sh[SH_SYMTAB].sh_entsize = sizeof(Elf64_Sym);
+
+  sh[SH_STRTAB].sh_type = SHT_STRTAB;
+  sh[SH_STRTAB].sh_offset = offset[SH_STRTAB];
+  sh[SH_STRTAB].sh_size = strtab->len;
+  sh[SH_STRTAB].sh_addralign = 1;
+
+  sh[SH_SHSTRTAB].sh_type = SHT_STRTAB;
+  sh[SH_SHSTRTAB].sh_offset = offset[SH_SHSTRTAB];
+  sh[SH_SHSTRTAB].sh_size = shstrtab->len;
+  sh[SH_SHSTRTAB].sh_addralign = 1;
+
+  // An empty `.note.GNU-stack` says that the stack needn't be executable
+  sh[SH_NOTESTACK].sh_type = SHT_PROGBITS;
+  sh[SH_NOTESTACK].sh_offset = offset[SH_NOTESTACK];
+  sh[SH_NOTESTACK].sh_addralign = 1;
+
+  pad(file, 8);
+  eh = (Elf64_Ehdr *)file->buf;
+  memset(eh, 0, sizeof(Elf64_Ehdr));
+  memcpy(eh->e_ident, ELFMAG, SELFMAG);
+  eh->e_ident[EI_CLASS] = ELFCLASS64;
+  eh->e_ident[EI_DATA] = ELFDATA2LSB;
+  eh->e_ident[EI_VERSION] = EV_CURRENT;
+  eh->e_ident[EI_OSABI] = ELFOSABI_SYSV;
+  eh->e_type = ET_REL;
+  eh->e_machine = EM_X86_64;
+  eh->e_version = EV_CURRENT;
+  eh->e_shoff = file->len;
+  eh->e_ehsize = sizeof(Elf64_Ehdr);
+  eh->e_shentsize = sizeof(Elf64_Shdr);
+  eh->e_shnum = NSHDRS;
+  eh->e_shstrndx = SH_SHSTRTAB;
+  outwrite(file, (char *)sh, sizeof(sh));
+
+  outputbytes(Output, file->buf, file->len);
+
+  freeoutbuf(file);
+  freeoutbuf(symtab);
+  freeoutbuf(strtab);
+  freeoutbuf(rela);
+  freeoutbuf(shstrtab);
+  freeencoding();
+}
+
+// The functions which a program run in memory can call, as `lib/printint.c`
+static void jitprintint(long x) {
+  printf("%ld\n", x);
+}
+
+static void jitprintchar(long x) {
+  putc((char)(x & 0x7f), stdout);
+}
+
+static struct {
+  char *name;
+  void *addr;
+} Builtins[] = {
+    {"printint", jitprintint},
+    {"printchar", jitprintchar},
+    {NULL}};
+
+// The code which `runobject()` calls to start the program. The backend
+// uses `%r12` and `%r13` without saving them, so it saves the registers
+// which a C function must preserve, then calls `main()`. The call's
+// displacement is filled in below.
+static char Entrycode[] = {
+    0x53,                          // push %rbx
+    0x41, 0x54,                    // push %r12
+    0x41, 0x55,                    // push %r13
+    0x41, 0x56,                    // push %r14
+    0x41, 0x57,                    // push %r15
+    0xe8, 0, 0, 0, 0,              // call main
+    0x41, 0x5f,                    // pop %r15
+    0x41, 0x5e,                    // pop %r14
+    0x41, 0x5d,                    // pop %r13
+    0x41, 0x5c,                    // pop %r12
+    0x5b,                          // pop %rbx
+    0xc3};                         // ret
+#define ENTRYCALL 10               // Offset of the call's displacement
+
+// Return the address of the builtin function `name`. Anything else is
+// missing at link time, which has no source line to report.
+static void *findbuiltin(char *name) {
+  for (int i = 0; Builtins[i].name; i++)
+    if (!strcmp(Builtins[i].name, name))
+      return Builtins[i].addr;
+  fprintf(stderr, "Undefined function: %s\n", name);
+  exit(1);
+}
+
+// Compare two symbols by their position, for `qsort()`
+static int byvalue(const void *a, const void *b) {
+  const struct objsym *p = *(struct objsym **)a, *q = *(struct objsym **)b;
+
+  return (p->value > q->value) - (p->value < q->value);
+}
+
+// Write `/tmp/perf-<pid>.map`, which names the code at each address for
+// `perf`. A function runs up to the next one, or the end of the code.
+static void writeperfmap(char *text, long textsize) {
+  struct objsym **funcs;
+  char name[64];
+  FILE *fh;
+  int i, n;
+
+  if ((funcs = malloc((Nsyms + 1) * sizeof(struct objsym *))) == NULL)
+    fatal("Unable to `malloc` in `writeperfmap()`");
+  for (i = n = 0; i < Nsyms; i++)
+    if (Syms[i].sec == SEC_TEXT && !islocal(i))
+      funcs[n++] = &Syms[i];
+  qsort(funcs, n, sizeof(struct objsym *), byvalue);
+
+  snprintf(name, sizeof(name), "/tmp/perf-%d.map", (int)getpid());
+  if ((fh = fopen(name, "w")) == NULL) {
+    free(funcs);
+    return;  // The program can still be run
+  }
+  for (i = 0; i < n; i++)
+    fprintf(fh, "%lx %lx %s\n", (unsigned long)(text + funcs[i]->value),
+            (i + 1 < n ? funcs[i + 1]->value : textsize) - funcs[i]->value, funcs[i]->name);
+  fclose(fh);
+  free(funcs);
+}
+
+// Encode the sections in `Output` into memory, then call the program's
+// `main()` and return its result.
+//
+// The sections go in one mapping, each starting on a new page: the code,
+// followed by a jump to each builtin function that it calls and by
+// `Entrycode[]`, then `.rodata`, `.data` and `.bss`. Keeping them
+// together means that all the 32-bit displacements reach. Once the
+// references are filled in, the code is made read-only and executable.
+int runobject(void) {
+  static int order[NSECTIONS] = {SEC_TEXT, SEC_RODATA, SEC_DATA, SEC_BSS};
+  long page = sysconf(_SC_PAGESIZE), start[NSECTIONS], size, textsize;
+  long *stub, entry;
+  char *mem, *p;
+  void *addr;
+  struct fixup *f;
+  struct objsym *s;
+  int i, sec, result;
+
+  encodeall();
+
+  // Each function outside the program gets an 8-byte-aligned jump
+  // through the address after it: `jmp *0(%rip)` then the address
+  if ((stub = calloc(Nsyms + 1, sizeof(long))) == NULL)
+    fatal("Unable to `malloc` in `runobject()`");
+  Code = Obj->sec[SEC_TEXT];
+  for (i = 0; i < Nfixups; i++) {
+    f = &Fixups[i];
+    s = &Syms[f->sym];
+    if (s->sec != -1 || stub[f->sym])
+      continue;
+    if (islocal(f->sym)) {
+      Curline = s->name;
+      objerror("Undefined label");
+    }
+    addr = findbuiltin(s->name);
+    pad(Code, 8);
+    stub[f->sym] = Code->len;
+    byte(0xff);
+    byte(0x25);
+    dword(0);
+    outwrite(Code, (char *)&addr, sizeof(addr));
+  }
+  entry = Code->len;
+  outwrite(Code, Entrycode, sizeof(Entrycode));
+  textsize = entry;
+
+  // Lay out the sections and copy them in
+  for (size = i = 0; i < NSECTIONS; i++) {
+    sec = order[i];
+    start[sec] = size;
+    size += (sec == SEC_BSS) ? Bsssize : Obj->sec[sec]->len;
+    size = (size + page - 1) / page * page;
+  }
+  if ((mem = mmap(NULL, size ? size : page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+    fatal("Unable to `mmap` in `runobject()`");
+  for (sec = 0; sec < NSECTIONS; sec++)
+    if (sec != SEC_BSS)
+      memcpy(mem + start[sec], Obj->sec[sec]->buf, Obj->sec[sec]->len);
+
+  // Fill in every reference, now that everything's address is known
+  for (i = 0; i < Nfixups; i++) {
+    f = &Fixups[i];
+    s = &Syms[f->sym];
+    if (s->sec == -1)
+      p = mem + stub[f->sym];
+    else
+      p = mem + start[s->sec] + s->value;
+    patch(mem, f->offset, p - (mem + f->offset + 4));
+  }
+
+  s = &Syms[findsym("main", 4)];
+  if (s->sec != SEC_TEXT) {
+    fprintf(stderr, "No `main()` function to run\n");
+    exit(1);
+  }
+  patch(mem, entry + ENTRYCALL, s->value - (entry + ENTRYCALL + 4));
+
+  if (mprotect(mem, start[SEC_RODATA], PROT_READ | PROT_EXEC) == -1)
+    fatal("Unable to `mprotect` in `runobject()`");
+  writeperfmap(mem, textsize);
+
+  result = ((int (*)(void))(mem + entry))();
+  fflush(stdout);
+
+  munmap(mem, size ? size : page);
+  free(stub);
+  freeencoding();
+  return result;
+}
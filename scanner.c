@@ -1,47 +1,152 @@
 #include "definitions.h"
 #include "data.h"
 #include "declarations.h"
+#include <pthread.h>
+#include <sched.h>
+#include <setjmp.h>
+#include <stdatomic.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 // Lexical scanning
 
-// Return the position of character `c` in string `s`, or -1 if not found
-static int chrpos(char *s, int c) {
-  char *p;
-  p = strchr(s, c);  // Returns NULL pointer if not found
-  return p ? p - s : -1;
+// Character classes, indexed by the (unsigned) character value
+enum {
+  CH_SPACE = 1,    // Whitespace skipped between tokens
+  CH_DIGIT = 2,    // Decimal digit
+  CH_IDSTART = 4,  // May start an identifier
+  CH_IDENT = 8,    // May continue an identifier
+};
+
+static const unsigned char Charclass[256] = {
+    [' '] = CH_SPACE,
+    ['\t'] = CH_SPACE,
+    ['\n'] = CH_SPACE,
+    ['\r'] = CH_SPACE,
+    ['\f'] = CH_SPACE,
+    ['0' ... '9'] = CH_DIGIT | CH_IDENT,
+    ['a' ... 'z'] = CH_IDSTART | CH_IDENT,
+    ['A' ... 'Z'] = CH_IDSTART | CH_IDENT,
+    ['_'] = CH_IDSTART | CH_IDENT,
+};
+
+#define charclass(c) (Charclass[(unsigned char)(c)])
+
+// The scanner's hot loops: skipping whitespace, finding the end of an identifier
+// and finding the next special character in a string literal. With SSE2, each
+// classifies 16 bytes per step. Loads may run up to 15 bytes past the character
+// that stops them; the `INPUT_PADDING` zero bytes after the buffer cover that,
+// since a zero byte stops every loop.
+#ifdef __SSE2__
+
+// Return a bitmask of the bytes in `v` that are equal to `c`
+#define bytemask(v, c) _mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_set1_epi8(c)))
+
+// Return a pointer past the run of whitespace at `p`, adding its newlines to `*lines`
+static char *spacerun(char *p, int *lines) {
+  unsigned int space, nl;
+  __m128i v;
+
+  while (1) {
+    v = _mm_loadu_si128((__m128i *)p);
+    nl = bytemask(v, '\n');
+    space = nl | bytemask(v, ' ') | bytemask(v, '\t') | bytemask(v, '\r') | bytemask(v, '\f');
+
+    if (space != 0xffff) {
+      space = __builtin_ctz(~space);  // Length of the whitespace in this block
+      *lines += __builtin_popcount(nl & ((1u << space) - 1));
+      return p + space;
+    }
+
+    *lines += __builtin_popcount(nl);
+    p += 16;
+  }
 }
 
-// Get the next character from the input file
-static int next(void) {
-  int c;
+// Return a pointer past the run of identifier characters at `p`
+static char *identrun(char *p) {
+  __m128i v, lower, alpha, digit;
+  unsigned int ident;
+
+  while (1) {
+    v = _mm_loadu_si128((__m128i *)p);
+    // Fold case so one signed range compare finds letters; bytes >= 0x80 are negative
+    lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                          _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+    digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                          _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    ident = _mm_movemask_epi8(_mm_or_si128(alpha, digit)) | bytemask(v, '_');
+
+    if (ident != 0xffff)
+      return p + __builtin_ctz(~ident);
+
+    p += 16;
+  }
+}
+
+// Return a pointer to the first quote, backslash, newline or zero byte at or after `p`
+static char *stringrun(char *p) {
+  unsigned int special;
+  __m128i v;
+
+  while (1) {
+    v = _mm_loadu_si128((__m128i *)p);
+    special = bytemask(v, '"') | bytemask(v, '\\') | bytemask(v, '\n') | bytemask(v, 0);
 
-  if (Putback) {
-    c = Putback;
-    Putback = 0;
-    return c;
+    if (special)
+      return p + __builtin_ctz(special);
+
+    p += 16;
   }
+}
 
-  c = fgetc(Infile);  // Read from input file
+#else
 
-  if ('\n' == c)
-    Line++;
+static char *spacerun(char *p, int *lines) {
+  while (charclass(*p) & CH_SPACE)
+    *lines += ('\n' == *p++);
+  return p;
+}
+
+static char *identrun(char *p) {
+  while (charclass(*p) & CH_IDENT)
+    p++;
+  return p;
+}
+
+static char *stringrun(char *p) {
+  while (*p && '"' != *p && '\\' != *p && '\n' != *p)
+    p++;
+  return p;
+}
+
+#endif
 
-  return c;
+// Get the next character from the input buffer
+static int next(void) {
+  if (Inptr >= Inend)
+    return EOF;
+
+  return (unsigned char)*Inptr++;
 }
 
+// Step back over the character just returned by `next()`
 static void putback(int c) {
-  Putback = c;
+  if (c != EOF)
+    Inptr--;
 }
 
-// Skip past unwanted input (e.g. whitespace, newlines) and then return the first character
+// Skip past unwanted input (e.g. whitespace, newlines) and then return the first character.
+// Newlines are only found here (outside of literals), so `Line` is counted in bulk over
+// each run of whitespace. The zero padding after the buffer stops the run at the end.
 static int skip(void) {
-  int c;
-  c = next();
-
-  while (' ' == c || '\t' == c || '\n' == c || '\r' == c || '\f' == c)
-    c = next();
+  int lines = 0;
 
-  return c;
+  Inptr = spacerun(Inptr, &lines);
+  Line += lines;
+  return next();
 }
 
 // Return the next character from a character or string literal.
@@ -49,6 +154,9 @@ static int skip(void) {
 static int scanch(void) {
   int c = next();
 
+  if (c == '\n')  // A raw newline inside a literal
+    Line++;
+
   if (c == '\\') {
     switch (c = next()) {
       case 'a':
@@ -79,120 +187,171 @@ static int scanch(void) {
   return c;  // An ordinary character
 }
 
-// Scan an integer literal from the input file and return it
+// Scan an integer literal from the input buffer and return it
 static int scanint(int c) {
-  int k, val = 0;
+  char *p = Inptr;
+  int val = c - '0';
 
   // Convert each character into an int value
-  while ((k = chrpos("0123456789", c)) >= 0) {
-    val = val * 10 + k;
-    c = next();
-  }
+  while (charclass(*p) & CH_DIGIT)
+    val = val * 10 + (*p++ - '0');
 
-  // We hit a non-integer character. Put it back.
-  putback(c);
+  // Leave the pointer at the first non-integer character
+  Inptr = p;
   return val;
 }
 
 // Scan in a string literal and store it in `buf[]`. Return the string's length.
+// Runs of ordinary characters are copied in bulk; only quotes, escapes,
+// newlines and the end of the input go through `scanch()`.
 static int scanstr(char *buf) {
-  int i, c;
+  int i = 0, c, n;
+  char *p;
+
+  while (1) {
+    p = stringrun(Inptr);
+
+    if (i + (n = p - Inptr) > TEXTLEN - 2)
+      fatal("String literal too long");
+
+    memcpy(buf + i, Inptr, n);
+    i += n;
+    Inptr = p;
 
-  for (i = 0; i < TEXTLEN - 1; i++) {
     if ((c = scanch()) == '"') {
       buf[i] = '\0';
       return i;
     }
-    buf[i] = c;
+    buf[i++] = c;
   }
-
-  fatal("String literal too long");
-
-  return 0;
 }
 
-// Scan an identifier from the input file and store it in `buf[]`. Return the identifier's length.
+// Scan an identifier from the input buffer and store it in `buf[]`. Return the identifier's
+// length. Its hash is computed on the way through and left in `Texthash`.
 static int scanident(int c, char *buf, int lim) {
-  int i = 0;
-
-  while (isalpha(c) || isdigit(c) || '_' == c) {
-    if (i >= lim - 1)
-      fatal("Identifier too long");
-
-    buf[i++] = c;
-
-    c = next();
-  }
-
-  // Put back final non-identifier character read. Terminate buffer and return its length.
-  putback(c);
-  buf[i] = '\0';
-  return i;
+  char *start = Inptr - 1;  // `c` has already been read
+  char *p = identrun(Inptr);
+  unsigned int h = HASHSTEP(HASHINIT, c);
+  int len;
+
+  // Hash the rest of the identifier, leaving `Inptr` after it
+  for (; Inptr < p; Inptr++)
+    h = HASHSTEP(h, *Inptr);
+
+  if ((len = p - start) >= lim)
+    fatal("Identifier too long");
+
+  // Copy the identifier out in one go. Terminate buffer and return its length.
+  memcpy(buf, start, len);
+  buf[len] = '\0';
+  Texthash = h;
+  return len;
 }
 
-// Return the token number for a given word from the input, or 0
-// if not a keyword. Switch on first character for efficiency.
-static int keyword(char *s) {
-  switch (*s) {
-    case 'c':
-      if (!strcmp(s, "char"))
-        return T_CHAR;
-      break;
-    case 'e':
-      if (!strcmp(s, "else"))
-        return T_ELSE;
-      break;
-    case 'f':
-      if (!strcmp(s, "for"))
-        return T_FOR;
-      break;
-    case 'i':
-      if (!strcmp(s, "if"))
-        return T_IF;
-      if (!strcmp(s, "int"))
-        return T_INT;
-      break;
-    case 'l':
-      if (!strcmp(s, "long"))
-        return T_LONG;
-      break;
-    case 'r':
-      if (!strcmp(s, "return"))
-        return T_RETURN;
-      break;
-    case 'w':
-      if (!strcmp(s, "while"))
-        return T_WHILE;
-      break;
-    case 'v':
-      if (!strcmp(s, "void"))
-        return T_VOID;
-      break;
-  }
+// Keywords are found with a perfect hash over the identifier hash from
+// `scanident()`: each keyword's slot is the low bits of its hash, and the
+// table is laid out by the compiler from the `KWHASHn()` constant expressions.
+// A new keyword must land on a free slot: a clash would silently replace the
+// keyword already there, so it is caught by the `_Static_assert` below.
+#define KWSLOTS 64
+
+#define KWHASH1(a) HASHSTEP(HASHINIT, a)
+#define KWHASH2(a, b) HASHSTEP(KWHASH1(a), b)
+#define KWHASH3(a, b, c) HASHSTEP(KWHASH2(a, b), c)
+#define KWHASH4(a, b, c, d) HASHSTEP(KWHASH3(a, b, c), d)
+#define KWHASH5(a, b, c, d, e) HASHSTEP(KWHASH4(a, b, c, d), e)
+#define KWHASH6(a, b, c, d, e, f) HASHSTEP(KWHASH5(a, b, c, d, e), f)
+
+#define KEYWORDS(X)                                        \
+  X("char", T_CHAR, KWHASH4('c', 'h', 'a', 'r'))           \
+  X("else", T_ELSE, KWHASH4('e', 'l', 's', 'e'))           \
+  X("for", T_FOR, KWHASH3('f', 'o', 'r'))                  \
+  X("if", T_IF, KWHASH2('i', 'f'))                         \
+  X("int", T_INT, KWHASH3('i', 'n', 't'))                  \
+  X("long", T_LONG, KWHASH4('l', 'o', 'n', 'g'))           \
+  X("return", T_RETURN, KWHASH6('r', 'e', 't', 'u', 'r', 'n')) \
+  X("void", T_VOID, KWHASH4('v', 'o', 'i', 'd'))           \
+  X("while", T_WHILE, KWHASH5('w', 'h', 'i', 'l', 'e'))
+
+#define KEYWORD(s, tok, hash) [(hash) & (KWSLOTS - 1)] = {s, sizeof(s) - 1, hash, tok},
+
+static const struct {
+  char *name;
+  int len;
+  unsigned int hash;
+  int token;
+} Keywords[KWSLOTS] = {KEYWORDS(KEYWORD)};
+
+// Each keyword's slot as a bit. Adding the bits gives the same as or-ing
+// them only if no two keywords have the same slot.
+#define KWBIT(s, tok, hash) (1ull << ((hash) & (KWSLOTS - 1)))
+#define KWOR(s, tok, hash) | KWBIT(s, tok, hash)
+#define KWADD(s, tok, hash) + KWBIT(s, tok, hash)
+
+_Static_assert((0 KEYWORDS(KWOR)) == (0 KEYWORDS(KWADD)), "Two keywords have the same slot in `Keywords[]`");
+
+// Return the token number for a word of length `len` and hash `hash` from
+// the input, or 0 if not a keyword. Non-keywords almost always fail on the
+// hash comparison, so they are never compared character by character.
+static int keyword(char *s, int len, unsigned int hash) {
+  int slot = hash & (KWSLOTS - 1);
+
+  if (Keywords[slot].hash == hash && Keywords[slot].len == len &&
+      !memcmp(s, Keywords[slot].name, len))
+    return Keywords[slot].token;
 
   return 0;
 }
 
-// A pointer to a rejected token
-static struct token *Rejtoken = NULL;
+// A rejected token, returned again by the next call to `scan()`
+static _Thread_local struct token Rejtoken;
+static _Thread_local int Rejected = 0;
 
 // Reject the last token scanned
 void reject_token(struct token *t) {
-  if (Rejtoken != NULL)
+  if (Tokens != NULL) {
+    if (t->token != T_EOF)  // `T_EOF` is never stepped past anyway
+      Tokpos--;             // The token array is simply re-read
+    return;
+  }
+
+  if (Rejected)
     fatal("Can't reject token twice");
-  Rejtoken = t;
+  Rejtoken = *t;
+  Rejected = 1;
 }
 
-// Updates passed-in `token` and returns 1 if valid token, 0 if EOF
-int scan(struct token *t) {
-  int c, tokentype;
-
-  if (Rejtoken != NULL) {
-    t = Rejtoken;
-    Rejtoken = NULL;
-    return 1;
+// Buffer for the text of the last identifier or string literal scanned from
+// the input, before it is interned
+static _Thread_local char Textbuf[TEXTLEN + 1];
+
+// Copy the current token from `Tokens[]` into `t` and advance.
+// The `T_EOF` token at the end of the array is returned repeatedly.
+// A `T_ERROR` token in its place is reported as the error it holds.
+static int nexttoken(struct token *t) {
+  struct token *tok = &Tokens[Tokpos];
+  char *msg;
+
+  *t = *tok;
+  Line = tok->line;
+  if (tok->token == T_EOF)
+    return 0;
+  if (tok->token == T_ERROR) {
+    if ((msg = strdup(Names[tok->nameid])) == NULL)
+      fatal("Unable to `malloc` in `nexttoken()`");
+    fatalmessage(msg);
   }
 
+  Tokpos++;
+  if (tok->token == T_IDENT || tok->token == T_STRLIT)
+    Text = Names[tok->nameid];
+  return 1;
+}
+
+// Scan the next token from the input into `t`. Return 1 if valid token, 0 if EOF
+static int lex(struct token *t) {
+  int c, len, tokentype;
+
   c = skip();
 
   switch (c) {
@@ -311,25 +470,29 @@ int scan(struct token *t) {
         fatal("Expected '\\'' at end of char literal");
       break;
     case '"':
-      // Scan in a literal string
-      scanstr(Text);
+      // Scan in a literal string and intern it
+      len = scanstr(Textbuf);
+      t->nameid = internid(Textbuf, len, strhash(Textbuf, len));
+      Text = Names[t->nameid];
       t->token = T_STRLIT;
       break;
     default:
-      if (isdigit(c)) {
+      if (charclass(c) & CH_DIGIT) {
         t->intvalue = scanint(c);
         t->token = T_INTLIT;
         break;
-      } else if (isalpha(c) || '_' == c) {
+      } else if (charclass(c) & CH_IDSTART) {
         // Read in a keyword or identifier
-        scanident(c, Text, TEXTLEN);
+        len = scanident(c, Textbuf, TEXTLEN);
 
-        if ((tokentype = keyword(Text))) {
+        if ((tokentype = keyword(Textbuf, len, Texthash))) {
           t->token = tokentype;
           break;
         }
 
-        // Not a recognized keyword; must be an identifier
+        // Not a recognized keyword; must be an identifier. Intern it, reusing its hash.
+        t->nameid = internid(Textbuf, len, Texthash);
+        Text = Names[t->nameid];
         t->token = T_IDENT;
         break;
       }
@@ -339,3 +502,194 @@ int scan(struct token *t) {
 
   return 1;  // We found a token
 }
+
+// With `-p`, a lexer thread scans the input while the parser runs, passing
+// the tokens through a ring buffer. There is one writer and one reader, so
+// each end only needs to see the other's position: the lexer publishes
+// `Ringhead` after filling a slot, and the parser publishes `Ringtail`
+// after emptying one. A fatal error on the lexer thread goes through the
+// ring in place of a token, so that it is reported when the parser gets
+// to it, just as if the token was scanned then.
+
+#define RINGSIZE 4096  // Slots in the ring, a power of 2
+
+struct ringslot {
+  struct token tok;  // The token, with the line it was found on
+  char *text;        // `Text` for the token
+  char *error;       // or the message of a fatal error
+};
+
+#define Ring (Ctx->ring)
+#define Ringhead (Ctx->ringhead)  // Count of slots filled by the lexer
+#define Ringtail (Ctx->ringtail)  // Count of slots emptied by the parser
+#define Lexthread (Ctx->lexthread)
+
+// Return the next slot for the lexer to fill, once there's room
+static struct ringslot *ringput(void) {
+  unsigned int head = atomic_load_explicit(&Ringhead, memory_order_relaxed);
+
+  while (head - atomic_load_explicit(&Ringtail, memory_order_acquire) == RINGSIZE)
+    sched_yield();
+  return &Ring[head & (RINGSIZE - 1)];
+}
+
+// Hand the slot from `ringput()` to the parser
+static void ringpublish(void) {
+  atomic_fetch_add_explicit(&Ringhead, 1, memory_order_release);
+}
+
+// A fatal error on the lexer thread: pass it on to the parser and stop
+static void lexfatal(char *msg) {
+  ringput()->error = msg;
+  ringpublish();
+  pthread_exit(NULL);
+}
+
+// The lexer thread: scan tokens into the ring up to the end of the input
+static void *lexer(void *arg) {
+  struct ringslot *slot;
+
+  Ctx = arg;
+  Line = 1;
+  Fatalhook = lexfatal;
+
+  do {
+    slot = ringput();
+    slot->tok.intvalue = slot->tok.nameid = 0;
+    lex(&slot->tok);
+    slot->tok.line = Line;
+    slot->text = Text;
+    slot->error = NULL;
+    ringpublish();
+  } while (slot->tok.token != T_EOF);
+
+  return NULL;
+}
+
+// Take the next token from the ring into `t`, waiting for the lexer if
+// need be. The `T_EOF` token at the end is returned repeatedly.
+static int ringtoken(struct token *t) {
+  unsigned int tail = atomic_load_explicit(&Ringtail, memory_order_relaxed);
+  struct ringslot *slot;
+
+  while (atomic_load_explicit(&Ringhead, memory_order_acquire) == tail)
+    sched_yield();
+
+  slot = &Ring[tail & (RINGSIZE - 1)];
+  if (slot->error)
+    fatalmessage(slot->error);
+
+  *t = slot->tok;
+  Line = slot->tok.line;
+  if (t->token == T_EOF)
+    return 0;
+
+  if (t->token == T_IDENT || t->token == T_STRLIT)
+    Text = slot->text;
+  atomic_store_explicit(&Ringtail, tail + 1, memory_order_release);
+  return 1;
+}
+
+// Start the lexer thread. From now on, `scan()` reads the tokens from it.
+void start_lexer(void) {
+  if ((Ring = malloc(RINGSIZE * sizeof(struct ringslot))) == NULL)
+    fatal("Unable to `malloc` in `start_lexer()`");
+
+  atomic_init(&Ringhead, 0);
+  atomic_init(&Ringtail, 0);
+  if (pthread_create(&Lexthread, NULL, lexer, Ctx) != 0)
+    fatal("Unable to create the lexer thread");
+}
+
+// Wait for the lexer thread, which has reached the end of the input
+void stop_lexer(void) {
+  pthread_join(Lexthread, NULL);
+  free(Ring);
+  Ring = NULL;
+}
+
+// Get the next token into `t`, from `Tokens[]`, the lexer thread or the
+// input. Return 1 if valid token, 0 if EOF.
+int scan(struct token *t) {
+  if (Tokens != NULL)
+    return nexttoken(t);
+
+  if (Rejected) {
+    *t = Rejtoken;
+    Rejected = 0;
+    return 1;
+  }
+
+  if (Ring != NULL)
+    return ringtoken(t);
+
+  return lex(t);
+}
+
+static _Thread_local int Tokencap;         // Capacity of `Tokens[]`
+static _Thread_local jmp_buf Tokenabort;   // Where `tokenize()` goes after a lexical error
+static _Thread_local char *Tokenerror;     // and the error's message
+
+// Add `t` to the end of `Tokens[]`
+static void addtoken(struct token *t) {
+  if (Ntokens == Tokencap) {
+    Tokencap *= 2;
+    if ((Tokens = realloc(Tokens, Tokencap * sizeof(struct token))) == NULL)
+      fatal("Unable to `realloc` in `addtoken()`");
+  }
+  Tokens[Ntokens++] = *t;
+}
+
+// A fatal error while tokenizing: go back to `tokenize()` with the message
+static void tokenfatal(char *msg) {
+  Tokenerror = msg;
+  longjmp(Tokenabort, 1);
+}
+
+// Scan the whole input into `Tokens[]`, which ends with a `T_EOF` token.
+// After this, `scan()` steps through the array instead of the input buffer.
+// Nothing is scanned until it's complete, so it's built in place, where
+// `free_tokens()` can find it after an error.
+//
+// A lexical error ends the array with a `T_ERROR` token instead, which holds
+// the message. It is reported when the parser gets to it, as the serial
+// build would, so any parse error before it is the one reported.
+void tokenize(void) {
+  void (*outer)(char *msg) = Fatalhook;
+  struct token t;
+
+  // Start with a guess of one token per four bytes of input
+  Tokencap = (Inend - Inbuf) / 4 + 16;
+  if ((Tokens = malloc(Tokencap * sizeof(struct token))) == NULL)
+    fatal("Unable to `malloc` in `tokenize()`");
+  Ntokens = 0;
+
+  if (setjmp(Tokenabort) == 0) {
+    do {
+      t.intvalue = t.nameid = 0;
+      Fatalhook = tokenfatal;
+      lex(&t);
+      Fatalhook = outer;
+      t.line = Line;
+      addtoken(&t);
+    } while (t.token != T_EOF);
+  } else {
+    Fatalhook = outer;
+    t.token = T_ERROR;
+    t.intvalue = 0;
+    t.nameid = internid(Tokenerror, strlen(Tokenerror), strhash(Tokenerror, strlen(Tokenerror)));
+    t.line = Line;
+    free(Tokenerror);
+    addtoken(&t);
+  }
+
+  Tokpos = 0;
+  Line = 1;
+}
+
+// Release the token array
+void free_tokens(void) {
+  free(Tokens);
+  Tokens = NULL;
+  Ntokens = Tokpos = 0;
+}
@@ -0,0 +1,338 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <errno.h>
+
+// Binary AST files.
+// With `-A`, the parser writes each function's AST to `out.ast` instead of
+// generating code for it, along with the global variables that would have
+// been output around it. With `-L`, these records are read back and the
+// code is generated without lexing or parsing: the output is the same as
+// compiling the source directly.
+//
+// The file starts with `ASTMAGIC` and `ASTVERSION`, then has a record for
+// each item in output order. Everything is written as native `int`s, so a
+// file can only be read on the same kind of machine. A record is one of:
+//
+// R_GLOBAL   symbol                  A new global symbol
+// R_FUNCTION nlocals nglobals nstrings root nwords symbols... words... strings...
+//
+// A function record holds all the function's locals, followed by each global
+// symbol that its tree refers to. Its tree is the words of `ASTbuf[]`, with
+// the symbol slot numbers changed to positions in the record's symbol list.
+// A symbol is its name's length and characters followed by `SYMFIELDS`
+// fields of `struct symtable`. The function's string literals are kept with
+// it: each is its label, its length and its characters. The labels are the
+// name ids from the compile which wrote the file, so they are kept as they
+// are, and the output uses the same labels.
+
+#define ASTMAGIC 0x54534142  // "BAST" in little-endian order
+#define ASTVERSION 3
+#define SYMFIELDS 9
+
+enum {
+  R_GLOBAL = 1,
+  R_FUNCTION,
+};
+
+static FILE *ASTfile;       // The AST file being written or read
+static char *ASTfilename;   // and its name, for error messages
+static int *Globalref;      // For each global slot, its position in the record's symbol list + 1
+static int Globalrefcap;    // Capacity of `Globalref[]`
+static int *Refslots;       // Slots of the globals in the record's symbol list
+static char *Namebuf;       // Buffer for reading names and strings
+static int Namebufcap;      // Capacity of `Namebuf[]`
+static int *Strlabels;      // Labels of the current function's string literals
+static char **Strvalues;    // and the literals themselves, which are interned
+static int Nstrings;        // Number of string literals in the current function
+static int Strcap;          // Capacity of `Strlabels[]` and `Strvalues[]`
+
+// Write `n` words to the AST file
+static void putwords(int *w, int n) {
+  if (fwrite(w, sizeof(int), n, ASTfile) != n)
+    fatals("Unable to write AST file", ASTfilename);
+}
+
+// Write one word to the AST file
+static void putword(int w) {
+  putwords(&w, 1);
+}
+
+// Write `len` characters to the AST file
+static void putchars(char *s, int len) {
+  if (fwrite(s, 1, len, ASTfile) != len)
+    fatals("Unable to write AST file", ASTfilename);
+}
+
+// Read `n` words from the AST file
+static void getwords(int *w, int n) {
+  if (fread(w, sizeof(int), n, ASTfile) != n)
+    fatals("Truncated AST file", ASTfilename);
+}
+
+// Read one word from the AST file
+static int getword(void) {
+  int w;
+
+  getwords(&w, 1);
+  return w;
+}
+
+// Read `len` characters from the AST file into `Namebuf[]`, NUL-terminated
+static char *getchars(int len) {
+  if (len < 0)
+    fatals("Corrupt AST file", ASTfilename);
+
+  if (len + 1 > Namebufcap) {
+    Namebufcap = len + 1;
+    if ((Namebuf = realloc(Namebuf, Namebufcap)) == NULL)
+      fatal("Unable to `realloc` in `getchars()`");
+  }
+
+  if (fread(Namebuf, 1, len, ASTfile) != len)
+    fatals("Truncated AST file", ASTfilename);
+  Namebuf[len] = '\0';
+  return Namebuf;
+}
+
+// Open the AST file to be written (`mode` "w") or read (`mode` "r").
+// A file to be written called `-` is the standard output.
+void open_astfile(char *filename, char *mode) {
+  ASTfilename = filename;
+  if (*mode == 'w' && !strcmp(filename, "-"))
+    ASTfile = stdout;
+  else if ((ASTfile = fopen(filename, *mode == 'w' ? "wb" : "rb")) == NULL) {
+    fprintf(stderr, "Unable to open %s: %s\n", filename, strerror(errno));
+    exit(1);
+  }
+
+  if (*mode == 'w') {
+    putword(ASTMAGIC);
+    putword(ASTVERSION);
+  } else if (getword() != ASTMAGIC || getword() != ASTVERSION)
+    fatals("Not an AST file from this compiler", filename);
+}
+
+// Close the AST file
+void close_astfile(void) {
+  if (fclose(ASTfile) == EOF)
+    fatals("Unable to write AST file", ASTfilename);
+  ASTfile = NULL;
+}
+
+// Write the symbol in `slot` to the AST file
+static void savesymbol(int slot) {
+  struct symtable *sym = SYMBOL(slot);
+  int len = strlen(sym->name);
+  int fields[SYMFIELDS] = {
+      sym->type, sym->stype, sym->class, sym->endlabel, sym->size,
+      sym->numelems, sym->shadowed, sym->scopestart, sym->scopeend};
+
+  putword(len);
+  putchars(sym->name, len);
+  putwords(fields, SYMFIELDS);
+}
+
+// Read a symbol from the AST file into `sym`, interning its name
+static void loadsymbol(struct symtable *sym) {
+  int len = getword();
+  char *name = getchars(len);
+  int fields[SYMFIELDS], id;
+
+  getwords(fields, SYMFIELDS);
+  id = internid(name, len, strhash(name, len));  // May move `Names[]`
+  sym->name = Names[id];
+  sym->type = fields[0];
+  sym->stype = fields[1];
+  sym->class = fields[2];
+  sym->endlabel = fields[3];
+  sym->size = fields[4];
+  sym->position = 0;
+  sym->numelems = fields[5];
+  sym->shadowed = fields[6];
+  sym->scopestart = fields[7];
+  sym->scopeend = fields[8];
+}
+
+// Record a new global symbol, in place of generating its storage
+void saveglobalsym(int slot) {
+  putword(R_GLOBAL);
+  savesymbol(slot);
+}
+
+// Record a string literal and its label, in place of generating it.
+// It is written out with the function that it's in.
+void savestrlit(int label, char *strvalue) {
+  if (Nstrings == Strcap) {
+    Strcap = Strcap ? Strcap * 2 : 16;
+    Strlabels = realloc(Strlabels, Strcap * sizeof(int));
+    Strvalues = realloc(Strvalues, Strcap * sizeof(char *));
+    if (Strlabels == NULL || Strvalues == NULL)
+      fatal("Unable to `realloc` in `savestrlit()`");
+  }
+
+  Strlabels[Nstrings] = label;
+  Strvalues[Nstrings++] = strvalue;
+}
+
+// Write a function's AST to the AST file, in place of generating its code.
+// The tree's symbol slots are rewritten in the process.
+void saveAST(int tree) {
+  int nwords = ASTsize(), nglobals = 0;
+  struct ASTnode *node;
+  int i, slot;
+
+  if (Globalrefcap < Globals) {
+    Globalrefcap = Globals;
+    Globalref = realloc(Globalref, Globalrefcap * sizeof(int));
+    Refslots = realloc(Refslots, Globalrefcap * sizeof(int));
+    if (Globalref == NULL || Refslots == NULL)
+      fatal("Unable to `realloc` in `saveAST()`");
+    memset(Globalref, 0, Globalrefcap * sizeof(int));
+  }
+
+  // Walk the nodes in order, changing each slot number to the symbol's
+  // position in the list: locals first, then globals as they are found
+  for (i = NOAST + 2; i < nwords; i += 2 + (node->flags & AST_NCHILD)) {
+    node = ASTNODE(i);
+    if (!hassymbol(node->op))
+      continue;
+
+    slot = node->v.id;
+    if (slot & LOCALSYM) {
+      node->v.id = slot & ~LOCALSYM;
+    } else {
+      if (Globalref[slot] == 0) {
+        Refslots[nglobals++] = slot;
+        Globalref[slot] = nglobals;
+      }
+      node->v.id = Locals + Globalref[slot] - 1;
+    }
+  }
+
+  putword(R_FUNCTION);
+  putword(Locals);
+  putword(nglobals);
+  putword(Nstrings);
+  putword(tree);
+  putword(nwords);
+
+  for (i = 0; i < Locals; i++)
+    savesymbol(LOCALSYM | i);
+  for (i = 0; i < nglobals; i++) {
+    savesymbol(Refslots[i]);
+    Globalref[Refslots[i]] = 0;  // Ready for the next function
+  }
+
+  // The words before the first node aren't used, so write them as zero
+  putword(0);
+  putword(0);
+  putwords(ASTbuf + NOAST + 2, nwords - NOAST - 2);
+
+  for (i = 0; i < Nstrings; i++) {
+    int len = strlen(Strvalues[i]);
+    putword(Strlabels[i]);
+    putword(len);
+    putchars(Strvalues[i], len);
+  }
+  Nstrings = 0;
+}
+
+// Read a global symbol and add it to the symbol table, which outputs its
+// storage. Return its slot number.
+static int loadglobal(void) {
+  struct symtable sym;
+
+  loadsymbol(&sym);
+  return addglobal(sym.name, sym.type, sym.stype, sym.class, sym.endlabel, sym.size);
+}
+
+// Read a function's AST and its symbols, and generate the function's code
+static void loadfunction(void) {
+  struct symtable sym;
+  int nlocals, nglobals, nstrings, tree, nwords;
+  int *slots, i, slot;
+  struct ASTnode *node;
+
+  nlocals = getword();
+  nglobals = getword();
+  nstrings = getword();
+  tree = getword();
+  nwords = getword();
+  if (nlocals < 0 || nglobals < 0 || nstrings < 0 || nwords < NOAST + 2 || tree < NOAST + 2 || tree >= nwords)
+    fatals("Corrupt AST file", ASTfilename);
+
+  if ((slots = malloc((nlocals + nglobals + 1) * sizeof(int))) == NULL)
+    fatal("Unable to `malloc` in `loadfunction()`");
+
+  // The locals come back in the same slots, in order. Globals are found by
+  // name, and only added if this is the first that we've heard of them. A
+  // function's end label is only given once its body is parsed, so it comes
+  // from this record.
+  for (i = 0; i < nlocals; i++) {
+    loadsymbol(&sym);
+    slots[i] = restorelocal(&sym);
+  }
+  for (; i < nlocals + nglobals; i++) {
+    loadsymbol(&sym);
+    if ((slots[i] = findglobal(sym.name)) == -1)
+      slots[i] = addglobal(sym.name, sym.type, sym.stype, sym.class, sym.endlabel, sym.size);
+    else if (SYMBOL(slots[i])->stype == S_FUNCTION && sym.endlabel)
+      SYMBOL(slots[i])->endlabel = sym.endlabel;
+  }
+
+  // Read the tree and put the symbol slot numbers back
+  getwords(setASTsize(nwords), nwords);
+  for (i = NOAST + 2; i < nwords; i += 2 + (node->flags & AST_NCHILD)) {
+    node = ASTNODE(i);
+    for (int c = 0; c < (node->flags & AST_NCHILD); c++)
+      if (node->child[c] < 0 || node->child[c] >= nwords)
+        fatals("Corrupt AST file", ASTfilename);
+    if (!hassymbol(node->op))
+      continue;
+
+    slot = node->v.id;
+    if (slot < 0 || slot >= nlocals + nglobals)
+      fatals("Corrupt AST file", ASTfilename);
+    node->v.id = slots[slot];
+  }
+  free(slots);
+
+  if (ASTNODE(tree)->op != A_FUNCTION)
+    fatals("Corrupt AST file", ASTfilename);
+
+  // Pool the string literals under their saved labels. The function's
+  // code is generated with it as the current function.
+  Functionid = ASTNODE(tree)->v.id;
+  for (i = 0; i < nstrings; i++) {
+    int label = getword();
+    poolstr(label, intern(getchars(getword())));
+  }
+
+  if (O_jobs)
+    genqueue(tree);
+  else {
+    genAST(tree, NOLABEL, 0);
+    genflush(Output);
+  }
+  freelocalsymbols();
+  freeASTnodes();
+}
+
+// Read the records of the AST file and generate code for them
+void loadASTfile(void) {
+  int kind;
+
+  while (fread(&kind, sizeof(int), 1, ASTfile) == 1) {
+    switch (kind) {
+      case R_GLOBAL:
+        loadglobal();
+        break;
+      case R_FUNCTION:
+        loadfunction();
+        break;
+      default:
+        fatals("Corrupt AST file", ASTfilename);
+    }
+  }
+}
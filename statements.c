@@ -5,19 +5,20 @@
 // Parsing of statements
 
 // Prototypes
-static struct ASTnode *single_statement(void);
+static int single_statement(void);
 
 // Parse an IF statement, including an optional ELSE clause, and return its AST
-static struct ASTnode *if_statement(void) {
-  struct ASTnode *condAST, *trueAST, *falseAST = NULL;
+static int if_statement(void) {
+  int condAST, trueAST, falseAST = NOAST;
+  int label;
 
   match(T_IF, "if");
   lparen();
 
   condAST = binexpr(0);
 
-  if (condAST->op < A_EQ || condAST->op > A_GE)
-    condAST = mkastunary(A_TOBOOL, condAST->type, condAST, 0);
+  if (ASTNODE(condAST)->op < A_EQ || ASTNODE(condAST)->op > A_GE)
+    condAST = mkastunary(A_TOBOOL, ASTNODE(condAST)->type, condAST, 0);
   rparen();
 
   trueAST = compound_statement();
@@ -27,36 +28,46 @@ static struct ASTnode *if_statement(void) {
     falseAST = compound_statement();
   }
 
-  return mkastnode(A_IF, P_NONE, condAST, trueAST, falseAST, 0);
+  // Get the labels for the false compound statement and, if there's an
+  // ELSE clause, the end of the overall IF statement
+  label = genlabel();
+  if (falseAST)
+    genlabel();
+
+  return mkastnode(A_IF, P_NONE, condAST, trueAST, falseAST, label);
 }
 
 // Parse a WHILE statement and return its AST
-static struct ASTnode *while_statement(void) {
-  struct ASTnode *condAST, *bodyAST;
+static int while_statement(void) {
+  int condAST, bodyAST, label;
 
   match(T_WHILE, "while");
   lparen();
 
   condAST = binexpr(0);
-  if (condAST->op < A_EQ || condAST->op > A_GE)
-    condAST = mkastunary(A_TOBOOL, condAST->type, condAST, 0);
+  if (ASTNODE(condAST)->op < A_EQ || ASTNODE(condAST)->op > A_GE)
+    condAST = mkastunary(A_TOBOOL, ASTNODE(condAST)->type, condAST, 0);
   rparen();
 
   bodyAST = compound_statement();
 
-  return mkastnode(A_WHILE, P_NONE, condAST, NULL, bodyAST, 0);
+  // Get the labels for the start and the end of the loop
+  label = genlabel();
+  genlabel();
+
+  return mkastnode(A_WHILE, P_NONE, condAST, NOAST, bodyAST, label);
 }
 
-static struct ASTnode *for_statement(void) {
-  struct ASTnode *condAST, *bodyAST, *preopAST, *postopAST, *tree;
+static int for_statement(void) {
+  int condAST, bodyAST, preopAST, postopAST, tree, label;
 
   match(T_FOR, "for");
   lparen();
   preopAST = single_statement();
   semi();
   condAST = binexpr(0);
-  if (condAST->op < A_EQ || condAST->op > A_GE)
-    condAST = mkastunary(A_TOBOOL, condAST->type, condAST, 0);
+  if (ASTNODE(condAST)->op < A_EQ || ASTNODE(condAST)->op > A_GE)
+    condAST = mkastunary(A_TOBOOL, ASTNODE(condAST)->type, condAST, 0);
   semi();
   postopAST = single_statement();
   rparen();
@@ -71,27 +82,29 @@ static struct ASTnode *for_statement(void) {
   //             compound  postop
 
   // Glue the compound statement and post-op tree together
-  tree = mkastnode(A_GLUE, P_NONE, bodyAST, NULL, postopAST, 0);
+  tree = mkastnode(A_GLUE, P_NONE, bodyAST, NOAST, postopAST, 0);
   // Make a WHILE loop with the condition and the body
-  tree = mkastnode(A_WHILE, P_NONE, condAST, NULL, tree, 0);
+  label = genlabel();
+  genlabel();
+  tree = mkastnode(A_WHILE, P_NONE, condAST, NOAST, tree, label);
   // Glue the pre-op tree and WHILE tree together
-  return mkastnode(A_GLUE, P_NONE, preopAST, NULL, tree, 0);
+  return mkastnode(A_GLUE, P_NONE, preopAST, NOAST, tree, 0);
 }
 
 // Parse a return statement and return its AST
-static struct ASTnode *return_statement(void) {
-  struct ASTnode *tree;
+static int return_statement(void) {
+  int tree;
 
-  if (Symtable[Functionid].type == P_VOID)
+  if (SYMBOL(Functionid)->type == P_VOID)
     fatal("Can't return from a `void` function");
 
   match(T_RETURN, "return");
   lparen();
 
   tree = binexpr(0);
-  tree = modify_type(tree, Symtable[Functionid].type, 0);
+  tree = modify_type(tree, SYMBOL(Functionid)->type, 0);
 
-  if (tree == NULL)
+  if (tree == NOAST)
     fatal("Incompatible type to return");
 
   tree = mkastunary(A_RETURN, P_NONE, tree, 0);
@@ -101,7 +114,7 @@ static struct ASTnode *return_statement(void) {
 }
 
 // Parse a single statement and return its AST
-static struct ASTnode *single_statement(void) {
+static int single_statement(void) {
   int type;
 
   switch (Token.token) {
@@ -116,7 +129,7 @@ static struct ASTnode *single_statement(void) {
       ident();
       variable_declaration(type, C_LOCAL);
       semi();
-      return NULL;  // No AST generated
+      return NOAST;  // No AST generated
     case T_IF:
       return if_statement();
     case T_WHILE:
@@ -132,30 +145,32 @@ static struct ASTnode *single_statement(void) {
 }
 
 // Parse a compound statement and return its AST
-struct ASTnode *compound_statement(void) {
-  struct ASTnode *left = NULL;
-  struct ASTnode *tree;
+int compound_statement(void) {
+  int left = NOAST;
+  int tree;
 
   lbrace();
+  openscope();
 
   while (1) {
     tree = single_statement();
 
     // Some statements must be followed by a semicolon
-    if (tree != NULL && (tree->op == A_ASSIGN || tree->op == A_RETURN || tree->op == A_FUNCCALL))
+    if (tree != NOAST && (ASTNODE(tree)->op == A_ASSIGN || ASTNODE(tree)->op == A_RETURN || ASTNODE(tree)->op == A_FUNCCALL))
       semi();
 
     // For each new tree, either save it in left (if empty), or glue current
     // left and the new tree together
-    if (tree != NULL) {
-      if (left == NULL)
+    if (tree != NOAST) {
+      if (left == NOAST)
         left = tree;
       else
-        left = mkastnode(A_GLUE, P_NONE, left, NULL, tree, 0);
+        left = mkastnode(A_GLUE, P_NONE, left, NOAST, tree, 0);
     }
 
     // When we reach this token, skip past it and return the AST
     if (Token.token == T_RBRACE) {
+      closescope();
       rbrace();
       return left;
     }
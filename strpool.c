@@ -0,0 +1,117 @@
+#include "definitions.h"
+#include "data.h"
+#include "declarations.h"
+#include <pthread.h>
+
+// String literal pooling.
+// Each string literal is output once, in `.rodata`, however many times it
+// appears in the program. A literal's label is its interned name id, so the
+// same text always has the same label, whichever function or thread it was
+// parsed in, and a function's code can refer to it before the pool is
+// output. The literals are collected here as they're parsed, and output by
+// `genpostamble()`.
+//
+// A literal which is the tail of a longer one doesn't get its own copy: its
+// label goes in the middle of the longer one. Sorting the literals by their
+// reversed text puts each one just before those it is a tail of.
+
+struct poolentry {
+  int label;   // The literal's label
+  char *str;   // and its text
+  int len;     // and length
+  int offset;  // Offset into the literal whose tail this is, or 0
+};
+
+#define Pool (Ctx->pool)          // The literals, in the order they were found
+#define Npool (Ctx->npool)        // Number of entries in `Pool[]`
+#define Poolcap (Ctx->poolcap)    // Capacity of `Pool[]`
+#define Poollock (Ctx->poollock)  // Bodies are parsed on worker threads with `-j`
+
+// Add the string literal `str`, whose label is `label`, to the pool
+void poolstr(int label, char *str) {
+  pthread_mutex_lock(&Poollock);
+  if (Npool == Poolcap) {
+    Poolcap = Poolcap ? Poolcap * 2 : 256;
+    if ((Pool = realloc(Pool, Poolcap * sizeof(struct poolentry))) == NULL)
+      fatal("Unable to `realloc` in `poolstr()`");
+  }
+
+  Pool[Npool].label = label;
+  Pool[Npool++].str = str;
+  pthread_mutex_unlock(&Poollock);
+}
+
+// Compare two pool entries by label, for `qsort()`
+static int bylabel(const void *a, const void *b) {
+  const struct poolentry *p = a, *q = b;
+
+  return (p->label > q->label) - (p->label < q->label);
+}
+
+// Compare two pool entries by their reversed text, for `qsort()`. A tail
+// of a literal sorts before it.
+static int byreversed(const void *a, const void *b) {
+  const struct poolentry *p = a, *q = b;
+  int i = p->len, j = q->len;
+
+  while (i > 0 && j > 0) {
+    i--;
+    j--;
+    if (p->str[i] != q->str[j])
+      return (unsigned char)p->str[i] - (unsigned char)q->str[j];
+  }
+  return (i > 0) - (j > 0);
+}
+
+// Output each string literal once, into `.rodata`
+void genstrpool(void) {
+  int i, n, owner, pos;
+
+  if (Npool == 0)
+    return;
+
+  // Keep one entry for each label
+  qsort(Pool, Npool, sizeof(struct poolentry), bylabel);
+  for (i = n = 0; i < Npool; i++)
+    if (n == 0 || Pool[i].label != Pool[n - 1].label)
+      Pool[n++] = Pool[i];
+  for (i = 0; i < n; i++)
+    Pool[i].len = strlen(Pool[i].str);
+
+  // Working down from the end, each entry is either the tail of the last
+  // one which was output in full, or is output in full itself
+  qsort(Pool, n, sizeof(struct poolentry), byreversed);
+  emitsection(SEC_RODATA);
+  owner = -1;
+  pos = 0;
+  for (i = n - 1; i >= 0; i--) {
+    if (owner != -1 && Pool[i].len <= Pool[owner].len &&
+        !memcmp(Pool[i].str, Pool[owner].str + Pool[owner].len - Pool[i].len, Pool[i].len)) {
+      Pool[i].offset = Pool[owner].len - Pool[i].len;
+    } else {
+      // Finish the literal before, and start this one
+      if (owner != -1)
+        cgstrchars(Pool[owner].str + pos, Pool[owner].len - pos, 1);
+      owner = i;
+      pos = 0;
+      Pool[i].offset = 0;
+    }
+
+    // The tails come in order of length, longest first, so each label is
+    // at or after the last one
+    if (Pool[i].offset > pos) {
+      cgstrchars(Pool[owner].str + pos, Pool[i].offset - pos, 0);
+      pos = Pool[i].offset;
+    }
+    cgstrlabel(Pool[i].label);
+  }
+  cgstrchars(Pool[owner].str + pos, Pool[owner].len - pos, 1);
+  freestrpool();
+}
+
+// Empty the pool
+void freestrpool(void) {
+  free(Pool);
+  Pool = NULL;
+  Npool = Poolcap = 0;
+}
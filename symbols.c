@@ -4,56 +4,253 @@
 
 // Symbol table functions
 
-// 0xxxx......................................xxxxxxxxxxxxNSYMBOLS-1
-//      ^                                    ^
-//      |                                    |
-//    Globals                              Locals/Parameters
+// Globals and locals are kept in separate arrays which grow as needed:
+//
+// Globalsyms: xxxxxxxxxxxx......   Localsyms: xxxxx........
+//                         ^                       ^
+//                       Globals                 Locals
+//
+// A symbol's slot number is its index in `Globalsyms[]`, or its index in
+// `Localsyms[]` with the `LOCALSYM` bit set; use `SYMBOL(slot)` to reach it.
+// Slot numbers don't change as the arrays grow, so the AST can hold them.
+//
+// Locals stay in `Localsyms[]` until the end of the function so that the code
+// generator can still see them, but each block's locals are only in the local
+// hash index while the block's scope is open. A local which hides one in an
+// outer scope takes over its index entry, and gives it back when its scope
+// is closed.
 
-// Determine if a symbol is in the global symbol table. Return its index or -1.
-int findglobal(char *s) {
-  for (int i = 0; i < Globals; i++) {
-    if (Symtable[i].class == C_PARAM)
+#define INITIAL_SYMBOLS 256  // Initial capacity of each symbol array
+
+#define Globalcap (Ctx->globalcap)  // Capacity of `Globalsyms[]`
+static _Thread_local int Localcap;  // Capacity of `Localsyms[]`
+
+// Symbol names are interned (see `intern.c`), so the `char *` arguments to the
+// functions below must be interned too, and names are compared by pointer.
+
+// Each region of the symbol table has a hash index from names to slot numbers
+// (`struct symindex`), using open addressing with linear probing, keyed on the
+// interned name pointer.
+
+#define INITIAL_INDEX 256  // Initial number of entries in an index
+
+#define Globalindex (Ctx->globalindex)             // Global symbols, except prototype parameters
+static _Thread_local struct symindex Localindex;   // Local symbols and parameters in open scopes
+
+#define INITIAL_SCOPES 16  // Initial capacity of `Scopes[]`
+
+static _Thread_local int *Scopes;     // For each open scope, the number of locals when it was opened
+static _Thread_local int Scopedepth;  // Number of open scopes
+static _Thread_local int Scopecap;    // Capacity of `Scopes[]`
+
+// Hash an interned name by its address
+static unsigned int namehash(char *name) {
+  return (unsigned int)(((unsigned long)name * 0x9E3779B97F4A7C15ul) >> 32);
+}
+
+// Return the symbol slot for `name` in the index, or -1 if not there.
+// A function body parsed on a worker thread (see `jobs.c`) only sees the
+// `Globals` that were declared before it, so later ones are skipped.
+static int indexfind(struct symindex *ix, char *name) {
+  int i, slot;
+
+  if (ix->size == 0)
+    return -1;
+
+  for (i = namehash(name) & (ix->size - 1); (slot = ix->slots[i]); i = (i + 1) & (ix->size - 1)) {
+    if (!((slot - 1) & LOCALSYM) && slot - 1 >= Globals)
       continue;
-    if (*s == *Symtable[i].name && !strcmp(s, Symtable[i].name))
-      return i;
+    if (SYMBOL(slot - 1)->name == name)
+      return slot - 1;
   }
 
   return -1;
 }
 
-// Get the index of a new global symbol; terminate if no more positions
+// Put symbol `slot` into the index entry for its name
+static void indexput(struct symindex *ix, int slot) {
+  int i = namehash(SYMBOL(slot)->name) & (ix->size - 1);
+
+  while (ix->slots[i])
+    i = (i + 1) & (ix->size - 1);
+
+  ix->slots[i] = slot + 1;
+}
+
+// Add symbol `slot` to the index, doubling the index when it's half full
+static void indexadd(struct symindex *ix, int slot) {
+  int *old = ix->slots;
+  int oldsize = ix->size;
+
+  if (2 * (ix->count + 1) > ix->size) {
+    ix->size = oldsize ? oldsize * 2 : INITIAL_INDEX;
+    if ((ix->slots = calloc(ix->size, sizeof(int))) == NULL)
+      fatal("Unable to `calloc` in `indexadd()`");
+
+    for (int i = 0; i < oldsize; i++)
+      if (old[i])
+        indexput(ix, old[i] - 1);
+    free(old);
+  }
+
+  indexput(ix, slot);
+  ix->count++;
+}
+
+// Make the index entry for symbol `oldslot` refer to `newslot`, which has the same name
+static void indexreplace(struct symindex *ix, int oldslot, int newslot) {
+  int i = namehash(SYMBOL(oldslot)->name) & (ix->size - 1);
+
+  while (ix->slots[i] != oldslot + 1)
+    i = (i + 1) & (ix->size - 1);
+
+  ix->slots[i] = newslot + 1;
+}
+
+// Remove symbol `slot` from the index. With linear probing, this is only safe
+// when symbols are removed in the reverse of the order that they were added.
+static void indexremove(struct symindex *ix, int slot) {
+  int i = namehash(SYMBOL(slot)->name) & (ix->size - 1);
+
+  while (ix->slots[i] != slot + 1)
+    i = (i + 1) & (ix->size - 1);
+
+  ix->slots[i] = 0;
+  ix->count--;
+}
+
+// Determine if a symbol is in the global symbol table. Return its index or -1.
+int findglobal(char *s) {
+  return indexfind(&Globalindex, s);
+}
+
+// Return `syms` resized to hold `*cap` symbols, doubling `*cap` first
+static struct symtable *growsymbols(struct symtable *syms, int *cap) {
+  *cap = *cap ? *cap * 2 : INITIAL_SYMBOLS;
+  if ((syms = realloc(syms, *cap * sizeof(struct symtable))) == NULL)
+    fatal("Unable to `realloc` in `growsymbols()`");
+  return syms;
+}
+
+// Keep an old copy of the global symbol table, to be freed at the end
+static void keepglobals(struct symtable *syms) {
+  struct compiler *c = Ctx;
+
+  if (c->noldglobals == c->oldglobalcap) {
+    c->oldglobalcap = c->oldglobalcap ? c->oldglobalcap * 2 : 16;
+    if ((c->oldglobals = realloc(c->oldglobals, c->oldglobalcap * sizeof(struct symtable *))) == NULL)
+      fatal("Unable to `realloc` in `keepglobals()`");
+  }
+  c->oldglobals[c->noldglobals++] = syms;
+}
+
+// Get the slot number of a new global symbol. With `-j`, functions queued
+// for code generation still use the table as it was (see `jobs.c`), so a
+// full table is copied to a bigger one and the old one is kept.
 static int newglobal(void) {
-  int p;
+  struct symtable *syms;
 
-  if ((p = Globals++) >= Locals)
-    fatal("Too many global symbols");
+  if (Globals == Globalcap && O_jobs) {
+    syms = Globalsyms;
+    Globalsyms = growsymbols(NULL, &Globalcap);
+    if (syms != NULL) {
+      memcpy(Globalsyms, syms, Globals * sizeof(struct symtable));
+      keepglobals(syms);
+    }
+  } else if (Globals == Globalcap)
+    Globalsyms = growsymbols(Globalsyms, &Globalcap);
 
-  return p;
+  return Globals++;
 }
 
 // Determine if a symbol is in the local symbol table. Return its index or -1.
 int findlocal(char *s) {
-  for (int i = Locals + 1; i < NSYMBOLS; i++) {
-    if (*s == *Symtable[i].name && !strcmp(s, Symtable[i].name))
-      return i;
+  return indexfind(&Localindex, s);
+}
+
+// Get the slot number of a new local symbol
+static int newlocal(void) {
+  if (Locals == Localcap)
+    Localsyms = growsymbols(Localsyms, &Localcap);
+
+  return LOCALSYM | Locals++;
+}
+
+// Return the number of locals that were declared before the innermost scope
+// was opened. A function's parameters are copied in before the scope of its
+// body is opened, so they count as part of that outermost scope.
+static int scopestart(void) {
+  return (Scopedepth > 1) ? Scopes[Scopedepth - 1] : 0;
+}
+
+// Open a new scope for local symbols
+void openscope(void) {
+  if (Scopedepth == Scopecap) {
+    Scopecap = Scopecap ? Scopecap * 2 : INITIAL_SCOPES;
+    if ((Scopes = realloc(Scopes, Scopecap * sizeof(int))) == NULL)
+      fatal("Unable to `realloc` in `openscope()`");
   }
 
-  return -1;
+  Scopes[Scopedepth++] = Locals;
 }
 
-// Get the index of a new local symbol; terminate if no more positions
-static int newlocal(void) {
-  int p;
+// Close the innermost scope. Its locals are taken out of the index newest
+// first, giving back the entries of any locals that they were hiding.
+void closescope(void) {
+  int start = scopestart();
 
-  if ((p = Locals--) <= Globals)
-    fatal("Too many local symbols");
+  for (int i = Locals - 1; i >= start; i--) {
+    // Skip over the locals of inner scopes, which have already gone
+    if (Localsyms[i].scopeend != 0) {
+      i = Localsyms[i].scopestart;
+      continue;
+    }
+
+    Localsyms[i].scopeend = Locals;
+    if (Localsyms[i].shadowed != -1)
+      indexreplace(&Localindex, LOCALSYM | i, Localsyms[i].shadowed);
+    else
+      indexremove(&Localindex, LOCALSYM | i);
+  }
 
-  return p;
+  Scopedepth--;
 }
 
-// Clear all entries in the local symbol table
+// Clear all entries in the local symbol table. Closing the function's
+// scopes has already taken them out of the index.
 void freelocalsymbols(void) {
-  Locals = NSYMBOLS - 1;
+  while (Scopedepth > 0)
+    closescope();
+
+  Locals = 0;
+}
+
+// Release this thread's local symbol table, along with its index and scopes.
+// After a fatal error these may be part way through a function.
+void freesymbols(void) {
+  free(Localsyms);
+  free(Localindex.slots);
+  free(Scopes);
+  Localsyms = NULL;
+  Localindex = (struct symindex){0};
+  Scopes = NULL;
+  Locals = Localcap = Scopedepth = Scopecap = 0;
+}
+
+// Release the global symbol table, and any old copies of it
+void freeglobalsymbols(void) {
+  struct compiler *c = Ctx;
+
+  for (int i = 0; i < c->noldglobals; i++)
+    free(c->oldglobals[i]);
+  free(c->oldglobals);
+  free(Globalsyms);
+  free(Globalindex.slots);
+  c->oldglobals = NULL;
+  c->noldglobals = c->oldglobalcap = 0;
+  Globalsyms = NULL;
+  Globalindex = (struct symindex){0};
+  Globals = Globalcap = 0;
 }
 
 // Update a symbol at the given slot number in the symbol table. Set up its:
@@ -65,15 +262,19 @@ void freelocalsymbols(void) {
 // - position: Position information for local symbols
 static void updatesymbol(
     int slot, char *name, int type, int stype, int class, int endlabel, int size, int position) {
-  if (slot < 0 || slot >= NSYMBOLS)
+  if (slot < 0 || (slot & ~LOCALSYM) >= ((slot & LOCALSYM) ? Locals : Globals))
     fatal("Invalid symbol slot number in `updatesymbol()`");
-  Symtable[slot].name = strdup(name);
-  Symtable[slot].type = type;
-  Symtable[slot].stype = stype;
-  Symtable[slot].class = class;
-  Symtable[slot].endlabel = endlabel;
-  Symtable[slot].size = size;
-  Symtable[slot].position = position;
+  SYMBOL(slot)->name = name;
+  SYMBOL(slot)->type = type;
+  SYMBOL(slot)->stype = stype;
+  SYMBOL(slot)->class = class;
+  SYMBOL(slot)->endlabel = endlabel;
+  SYMBOL(slot)->size = size;
+  SYMBOL(slot)->position = position;
+  SYMBOL(slot)->numelems = 0;
+  SYMBOL(slot)->shadowed = -1;
+  SYMBOL(slot)->scopestart = 0;
+  SYMBOL(slot)->scopeend = 0;
 }
 
 // Add a global symbol to the symbol table and return its index. Set up its:
@@ -91,27 +292,49 @@ int addglobal(char *name, int type, int stype, int class, int endlabel, int size
   globalslot = newglobal();
   updatesymbol(globalslot, name, type, stype, class, endlabel, size, 0);
 
+  // Prototype parameters are only found by their position after the function
+  if (class != C_PARAM)
+    indexadd(&Globalindex, globalslot);
+
   if (class == C_GLOBAL)
     genglobalsym(globalslot);
 
   return globalslot;
 }
 
-// Add a local symbol to the symbol table and return its index, or -1 if duplicate.
-// Set up its:
+// Add a local symbol to the symbol table and return its index, or -1 if it's
+// a duplicate in the current scope. It hides any local of the same name in an
+// outer scope. Set up its:
 // - type: char, int etc.
 // - structural type: var, function, array etc.
 // - class: `C_LOCAL` or `C_PARAM`
 // - size: number of elements
 int addlocal(char *name, int type, int stype, int class, int size) {
-  int localslot;
+  int localslot, outerslot;
 
-  if ((localslot = findlocal(name)) != -1)
+  if ((outerslot = findlocal(name)) != -1 && (outerslot & ~LOCALSYM) >= scopestart())
     return -1;
 
   localslot = newlocal();
   updatesymbol(localslot, name, type, stype, class, 0, size, 0);
+  SYMBOL(localslot)->scopestart = scopestart();
+
+  if (outerslot != -1) {
+    SYMBOL(localslot)->shadowed = outerslot;
+    indexreplace(&Localindex, outerslot, localslot);
+  } else
+    indexadd(&Localindex, localslot);
+
+  return localslot;
+}
+
+// Add a copy of a local symbol read back from an AST file (see `serialize.c`)
+// and return its slot number. It isn't put in the index, as the scopes of its
+// function have already been closed.
+int restorelocal(struct symtable *sym) {
+  int localslot = newlocal();
 
+  *SYMBOL(localslot) = *sym;
   return localslot;
 }
 
@@ -120,14 +343,14 @@ int addlocal(char *name, int type, int stype, int class, int size) {
 void copyfuncparams(int slot) {
   for (
       int i = 0, id = slot + 1;
-      i < Symtable[slot].numelems;
+      i < SYMBOL(slot)->numelems;
       i++, id++) {
     addlocal(
-        Symtable[id].name,
-        Symtable[id].type,
-        Symtable[id].stype,
-        Symtable[id].class,
-        Symtable[id].size);
+        SYMBOL(id)->name,
+        SYMBOL(id)->type,
+        SYMBOL(id)->stype,
+        SYMBOL(id)->class,
+        SYMBOL(id)->size);
   }
 }
 
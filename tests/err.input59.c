@@ -0,0 +1 @@
+Syntax error, token: 34 on line 3
@@ -0,0 +1 @@
+Unknown variable: x on line 2
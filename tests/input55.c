@@ -0,0 +1,16 @@
+int main() {
+  int a; int i;
+  a= 1; printint(a);
+  if (a == 1) {
+    int a; long b;
+    a= 2; b= 3; printint(a); printint(b);
+    if (a == 2) { char a; a= 4; printint(a); }
+    printint(a);
+  }
+  printint(a);
+  for (i= 0; i < 2; i= i + 1) {
+    int c; c= i + 10; printint(c);
+  }
+  while (a < 3) { long d; d= a; printint(d); a= a + 1; }
+  return(0);
+}
@@ -0,0 +1,17 @@
+int table[1000000];
+char c;
+long big[10];
+
+int main() {
+  int i;
+  for (i= 0; i < 1000000; i= i + 250000) {
+    table[i]= i;
+  }
+  printint(table[750000]);
+  printint(table[999999]);
+  big[9]= 5;
+  printint(big[9] + big[8]);
+  c= 7;
+  printint(c);
+  return(0);
+}
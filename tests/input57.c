@@ -0,0 +1,18 @@
+char *msg;
+
+void show() {
+  while (*msg) {
+    printchar(*msg);
+    msg= msg + 1;
+  }
+}
+
+int main() {
+  msg= "Hello world\n"; show();
+  msg= "world\n"; show();
+  msg= "Hello world\n"; show();
+  msg= "\ttab and \\ backslash\n"; show();
+  msg= ""; show();
+  msg= "rld\n"; show();
+  return(0);
+}
@@ -0,0 +1,49 @@
+int g;
+char gc;
+long gl;
+int garr[20];
+char *str;
+
+int twice() {
+  return(g + g);
+}
+
+int main() {
+  int i;
+  long l;
+  int *p;
+  int x;
+
+  g= 1000; gc= 65; gl= 300000;
+  printint(g * 3 - 7);
+  printint(gl / 7);
+  printint(g << 2);
+  printint(g >> 3);
+  printint(g & 255);
+  printint(g | 7);
+  printint(g ^ 15);
+  printint(-g);
+  printint(~g);
+  printint(!g);
+  printint(gc);
+  for (i= 0; i < 20; i= i + 1) {
+    garr[i]= i * i;
+  }
+  printint(garr[19]);
+  x= 12; p= &x; *p= *p + 30; printint(x);
+  gc= 200; x= gc++; x= gc++ + gc--; printint(gc);
+  gl= 5; l= ++gl; printint(l);
+  x= --g; printint(g);
+  x= i == 20; printint(x);
+  x= i != 20; printint(x);
+  x= i <= 19; printint(x);
+  x= i >= 21; printint(x);
+  x= i > 19; printint(x);
+  g= 21; x= twice(); printint(x);
+  str= "Done\n";
+  while (*str) {
+    printchar(*str);
+    str= str + 1;
+  }
+  return(0);
+}
@@ -0,0 +1,7 @@
+int x;
+int main() {
+  x= 2 +;
+  return(0);
+}
+
+int y; y= 1 @ 2;
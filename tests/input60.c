@@ -0,0 +1,3010 @@
+int f0() { return(0); }
+int f1() { return(1); }
+int f2() { return(2); }
+int f3() { return(3); }
+int f4() { return(4); }
+int f5() { return(5); }
+int f6() { return(6); }
+int f7() { return(7); }
+int f8() { return(8); }
+int f9() { return(9); }
+int f10() { return(10); }
+int f11() { return(11); }
+int f12() { return(12); }
+int f13() { return(13); }
+int f14() { return(14); }
+int f15() { return(15); }
+int f16() { return(16); }
+int f17() { return(17); }
+int f18() { return(18); }
+int f19() { return(19); }
+int f20() { return(20); }
+int f21() { return(21); }
+int f22() { return(22); }
+int f23() { return(23); }
+int f24() { return(24); }
+int f25() { return(25); }
+int f26() { return(26); }
+int f27() { return(27); }
+int f28() { return(28); }
+int f29() { return(29); }
+int f30() { return(30); }
+int f31() { return(31); }
+int f32() { return(32); }
+int f33() { return(33); }
+int f34() { return(34); }
+int f35() { return(35); }
+int f36() { return(36); }
+int f37() { return(37); }
+int f38() { return(38); }
+int f39() { return(39); }
+int f40() { return(40); }
+int f41() { return(41); }
+int f42() { return(42); }
+int f43() { return(43); }
+int f44() { return(44); }
+int f45() { return(45); }
+int f46() { return(46); }
+int f47() { return(47); }
+int f48() { return(48); }
+int f49() { return(49); }
+int f50() { return(50); }
+int f51() { return(51); }
+int f52() { return(52); }
+int f53() { return(53); }
+int f54() { return(54); }
+int f55() { return(55); }
+int f56() { return(56); }
+int f57() { return(57); }
+int f58() { return(58); }
+int f59() { return(59); }
+int f60() { return(60); }
+int f61() { return(61); }
+int f62() { return(62); }
+int f63() { return(63); }
+int f64() { return(64); }
+int f65() { return(65); }
+int f66() { return(66); }
+int f67() { return(67); }
+int f68() { return(68); }
+int f69() { return(69); }
+int f70() { return(70); }
+int f71() { return(71); }
+int f72() { return(72); }
+int f73() { return(73); }
+int f74() { return(74); }
+int f75() { return(75); }
+int f76() { return(76); }
+int f77() { return(77); }
+int f78() { return(78); }
+int f79() { return(79); }
+int f80() { return(80); }
+int f81() { return(81); }
+int f82() { return(82); }
+int f83() { return(83); }
+int f84() { return(84); }
+int f85() { return(85); }
+int f86() { return(86); }
+int f87() { return(87); }
+int f88() { return(88); }
+int f89() { return(89); }
+int f90() { return(90); }
+int f91() { return(91); }
+int f92() { return(92); }
+int f93() { return(93); }
+int f94() { return(94); }
+int f95() { return(95); }
+int f96() { return(96); }
+int f97() { return(97); }
+int f98() { return(98); }
+int f99() { return(99); }
+int f100() { return(100); }
+int f101() { return(101); }
+int f102() { return(102); }
+int f103() { return(103); }
+int f104() { return(104); }
+int f105() { return(105); }
+int f106() { return(106); }
+int f107() { return(107); }
+int f108() { return(108); }
+int f109() { return(109); }
+int f110() { return(110); }
+int f111() { return(111); }
+int f112() { return(112); }
+int f113() { return(113); }
+int f114() { return(114); }
+int f115() { return(115); }
+int f116() { return(116); }
+int f117() { return(117); }
+int f118() { return(118); }
+int f119() { return(119); }
+int f120() { return(120); }
+int f121() { return(121); }
+int f122() { return(122); }
+int f123() { return(123); }
+int f124() { return(124); }
+int f125() { return(125); }
+int f126() { return(126); }
+int f127() { return(127); }
+int f128() { return(128); }
+int f129() { return(129); }
+int f130() { return(130); }
+int f131() { return(131); }
+int f132() { return(132); }
+int f133() { return(133); }
+int f134() { return(134); }
+int f135() { return(135); }
+int f136() { return(136); }
+int f137() { return(137); }
+int f138() { return(138); }
+int f139() { return(139); }
+int f140() { return(140); }
+int f141() { return(141); }
+int f142() { return(142); }
+int f143() { return(143); }
+int f144() { return(144); }
+int f145() { return(145); }
+int f146() { return(146); }
+int f147() { return(147); }
+int f148() { return(148); }
+int f149() { return(149); }
+int f150() { return(150); }
+int f151() { return(151); }
+int f152() { return(152); }
+int f153() { return(153); }
+int f154() { return(154); }
+int f155() { return(155); }
+int f156() { return(156); }
+int f157() { return(157); }
+int f158() { return(158); }
+int f159() { return(159); }
+int f160() { return(160); }
+int f161() { return(161); }
+int f162() { return(162); }
+int f163() { return(163); }
+int f164() { return(164); }
+int f165() { return(165); }
+int f166() { return(166); }
+int f167() { return(167); }
+int f168() { return(168); }
+int f169() { return(169); }
+int f170() { return(170); }
+int f171() { return(171); }
+int f172() { return(172); }
+int f173() { return(173); }
+int f174() { return(174); }
+int f175() { return(175); }
+int f176() { return(176); }
+int f177() { return(177); }
+int f178() { return(178); }
+int f179() { return(179); }
+int f180() { return(180); }
+int f181() { return(181); }
+int f182() { return(182); }
+int f183() { return(183); }
+int f184() { return(184); }
+int f185() { return(185); }
+int f186() { return(186); }
+int f187() { return(187); }
+int f188() { return(188); }
+int f189() { return(189); }
+int f190() { return(190); }
+int f191() { return(191); }
+int f192() { return(192); }
+int f193() { return(193); }
+int f194() { return(194); }
+int f195() { return(195); }
+int f196() { return(196); }
+int f197() { return(197); }
+int f198() { return(198); }
+int f199() { return(199); }
+int f200() { return(200); }
+int f201() { return(201); }
+int f202() { return(202); }
+int f203() { return(203); }
+int f204() { return(204); }
+int f205() { return(205); }
+int f206() { return(206); }
+int f207() { return(207); }
+int f208() { return(208); }
+int f209() { return(209); }
+int f210() { return(210); }
+int f211() { return(211); }
+int f212() { return(212); }
+int f213() { return(213); }
+int f214() { return(214); }
+int f215() { return(215); }
+int f216() { return(216); }
+int f217() { return(217); }
+int f218() { return(218); }
+int f219() { return(219); }
+int f220() { return(220); }
+int f221() { return(221); }
+int f222() { return(222); }
+int f223() { return(223); }
+int f224() { return(224); }
+int f225() { return(225); }
+int f226() { return(226); }
+int f227() { return(227); }
+int f228() { return(228); }
+int f229() { return(229); }
+int f230() { return(230); }
+int f231() { return(231); }
+int f232() { return(232); }
+int f233() { return(233); }
+int f234() { return(234); }
+int f235() { return(235); }
+int f236() { return(236); }
+int f237() { return(237); }
+int f238() { return(238); }
+int f239() { return(239); }
+int f240() { return(240); }
+int f241() { return(241); }
+int f242() { return(242); }
+int f243() { return(243); }
+int f244() { return(244); }
+int f245() { return(245); }
+int f246() { return(246); }
+int f247() { return(247); }
+int f248() { return(248); }
+int f249() { return(249); }
+int f250() { return(250); }
+int f251() { return(251); }
+int f252() { return(252); }
+int f253() { return(253); }
+int f254() { return(254); }
+int f255() { return(255); }
+int f256() { return(256); }
+int f257() { return(257); }
+int f258() { return(258); }
+int f259() { return(259); }
+int f260() { return(260); }
+int f261() { return(261); }
+int f262() { return(262); }
+int f263() { return(263); }
+int f264() { return(264); }
+int f265() { return(265); }
+int f266() { return(266); }
+int f267() { return(267); }
+int f268() { return(268); }
+int f269() { return(269); }
+int f270() { return(270); }
+int f271() { return(271); }
+int f272() { return(272); }
+int f273() { return(273); }
+int f274() { return(274); }
+int f275() { return(275); }
+int f276() { return(276); }
+int f277() { return(277); }
+int f278() { return(278); }
+int f279() { return(279); }
+int f280() { return(280); }
+int f281() { return(281); }
+int f282() { return(282); }
+int f283() { return(283); }
+int f284() { return(284); }
+int f285() { return(285); }
+int f286() { return(286); }
+int f287() { return(287); }
+int f288() { return(288); }
+int f289() { return(289); }
+int f290() { return(290); }
+int f291() { return(291); }
+int f292() { return(292); }
+int f293() { return(293); }
+int f294() { return(294); }
+int f295() { return(295); }
+int f296() { return(296); }
+int f297() { return(297); }
+int f298() { return(298); }
+int f299() { return(299); }
+int f300() { return(300); }
+int f301() { return(301); }
+int f302() { return(302); }
+int f303() { return(303); }
+int f304() { return(304); }
+int f305() { return(305); }
+int f306() { return(306); }
+int f307() { return(307); }
+int f308() { return(308); }
+int f309() { return(309); }
+int f310() { return(310); }
+int f311() { return(311); }
+int f312() { return(312); }
+int f313() { return(313); }
+int f314() { return(314); }
+int f315() { return(315); }
+int f316() { return(316); }
+int f317() { return(317); }
+int f318() { return(318); }
+int f319() { return(319); }
+int f320() { return(320); }
+int f321() { return(321); }
+int f322() { return(322); }
+int f323() { return(323); }
+int f324() { return(324); }
+int f325() { return(325); }
+int f326() { return(326); }
+int f327() { return(327); }
+int f328() { return(328); }
+int f329() { return(329); }
+int f330() { return(330); }
+int f331() { return(331); }
+int f332() { return(332); }
+int f333() { return(333); }
+int f334() { return(334); }
+int f335() { return(335); }
+int f336() { return(336); }
+int f337() { return(337); }
+int f338() { return(338); }
+int f339() { return(339); }
+int f340() { return(340); }
+int f341() { return(341); }
+int f342() { return(342); }
+int f343() { return(343); }
+int f344() { return(344); }
+int f345() { return(345); }
+int f346() { return(346); }
+int f347() { return(347); }
+int f348() { return(348); }
+int f349() { return(349); }
+int f350() { return(350); }
+int f351() { return(351); }
+int f352() { return(352); }
+int f353() { return(353); }
+int f354() { return(354); }
+int f355() { return(355); }
+int f356() { return(356); }
+int f357() { return(357); }
+int f358() { return(358); }
+int f359() { return(359); }
+int f360() { return(360); }
+int f361() { return(361); }
+int f362() { return(362); }
+int f363() { return(363); }
+int f364() { return(364); }
+int f365() { return(365); }
+int f366() { return(366); }
+int f367() { return(367); }
+int f368() { return(368); }
+int f369() { return(369); }
+int f370() { return(370); }
+int f371() { return(371); }
+int f372() { return(372); }
+int f373() { return(373); }
+int f374() { return(374); }
+int f375() { return(375); }
+int f376() { return(376); }
+int f377() { return(377); }
+int f378() { return(378); }
+int f379() { return(379); }
+int f380() { return(380); }
+int f381() { return(381); }
+int f382() { return(382); }
+int f383() { return(383); }
+int f384() { return(384); }
+int f385() { return(385); }
+int f386() { return(386); }
+int f387() { return(387); }
+int f388() { return(388); }
+int f389() { return(389); }
+int f390() { return(390); }
+int f391() { return(391); }
+int f392() { return(392); }
+int f393() { return(393); }
+int f394() { return(394); }
+int f395() { return(395); }
+int f396() { return(396); }
+int f397() { return(397); }
+int f398() { return(398); }
+int f399() { return(399); }
+int f400() { return(400); }
+int f401() { return(401); }
+int f402() { return(402); }
+int f403() { return(403); }
+int f404() { return(404); }
+int f405() { return(405); }
+int f406() { return(406); }
+int f407() { return(407); }
+int f408() { return(408); }
+int f409() { return(409); }
+int f410() { return(410); }
+int f411() { return(411); }
+int f412() { return(412); }
+int f413() { return(413); }
+int f414() { return(414); }
+int f415() { return(415); }
+int f416() { return(416); }
+int f417() { return(417); }
+int f418() { return(418); }
+int f419() { return(419); }
+int f420() { return(420); }
+int f421() { return(421); }
+int f422() { return(422); }
+int f423() { return(423); }
+int f424() { return(424); }
+int f425() { return(425); }
+int f426() { return(426); }
+int f427() { return(427); }
+int f428() { return(428); }
+int f429() { return(429); }
+int f430() { return(430); }
+int f431() { return(431); }
+int f432() { return(432); }
+int f433() { return(433); }
+int f434() { return(434); }
+int f435() { return(435); }
+int f436() { return(436); }
+int f437() { return(437); }
+int f438() { return(438); }
+int f439() { return(439); }
+int f440() { return(440); }
+int f441() { return(441); }
+int f442() { return(442); }
+int f443() { return(443); }
+int f444() { return(444); }
+int f445() { return(445); }
+int f446() { return(446); }
+int f447() { return(447); }
+int f448() { return(448); }
+int f449() { return(449); }
+int f450() { return(450); }
+int f451() { return(451); }
+int f452() { return(452); }
+int f453() { return(453); }
+int f454() { return(454); }
+int f455() { return(455); }
+int f456() { return(456); }
+int f457() { return(457); }
+int f458() { return(458); }
+int f459() { return(459); }
+int f460() { return(460); }
+int f461() { return(461); }
+int f462() { return(462); }
+int f463() { return(463); }
+int f464() { return(464); }
+int f465() { return(465); }
+int f466() { return(466); }
+int f467() { return(467); }
+int f468() { return(468); }
+int f469() { return(469); }
+int f470() { return(470); }
+int f471() { return(471); }
+int f472() { return(472); }
+int f473() { return(473); }
+int f474() { return(474); }
+int f475() { return(475); }
+int f476() { return(476); }
+int f477() { return(477); }
+int f478() { return(478); }
+int f479() { return(479); }
+int f480() { return(480); }
+int f481() { return(481); }
+int f482() { return(482); }
+int f483() { return(483); }
+int f484() { return(484); }
+int f485() { return(485); }
+int f486() { return(486); }
+int f487() { return(487); }
+int f488() { return(488); }
+int f489() { return(489); }
+int f490() { return(490); }
+int f491() { return(491); }
+int f492() { return(492); }
+int f493() { return(493); }
+int f494() { return(494); }
+int f495() { return(495); }
+int f496() { return(496); }
+int f497() { return(497); }
+int f498() { return(498); }
+int f499() { return(499); }
+int f500() { return(500); }
+int f501() { return(501); }
+int f502() { return(502); }
+int f503() { return(503); }
+int f504() { return(504); }
+int f505() { return(505); }
+int f506() { return(506); }
+int f507() { return(507); }
+int f508() { return(508); }
+int f509() { return(509); }
+int f510() { return(510); }
+int f511() { return(511); }
+int f512() { return(512); }
+int f513() { return(513); }
+int f514() { return(514); }
+int f515() { return(515); }
+int f516() { return(516); }
+int f517() { return(517); }
+int f518() { return(518); }
+int f519() { return(519); }
+int f520() { return(520); }
+int f521() { return(521); }
+int f522() { return(522); }
+int f523() { return(523); }
+int f524() { return(524); }
+int f525() { return(525); }
+int f526() { return(526); }
+int f527() { return(527); }
+int f528() { return(528); }
+int f529() { return(529); }
+int f530() { return(530); }
+int f531() { return(531); }
+int f532() { return(532); }
+int f533() { return(533); }
+int f534() { return(534); }
+int f535() { return(535); }
+int f536() { return(536); }
+int f537() { return(537); }
+int f538() { return(538); }
+int f539() { return(539); }
+int f540() { return(540); }
+int f541() { return(541); }
+int f542() { return(542); }
+int f543() { return(543); }
+int f544() { return(544); }
+int f545() { return(545); }
+int f546() { return(546); }
+int f547() { return(547); }
+int f548() { return(548); }
+int f549() { return(549); }
+int f550() { return(550); }
+int f551() { return(551); }
+int f552() { return(552); }
+int f553() { return(553); }
+int f554() { return(554); }
+int f555() { return(555); }
+int f556() { return(556); }
+int f557() { return(557); }
+int f558() { return(558); }
+int f559() { return(559); }
+int f560() { return(560); }
+int f561() { return(561); }
+int f562() { return(562); }
+int f563() { return(563); }
+int f564() { return(564); }
+int f565() { return(565); }
+int f566() { return(566); }
+int f567() { return(567); }
+int f568() { return(568); }
+int f569() { return(569); }
+int f570() { return(570); }
+int f571() { return(571); }
+int f572() { return(572); }
+int f573() { return(573); }
+int f574() { return(574); }
+int f575() { return(575); }
+int f576() { return(576); }
+int f577() { return(577); }
+int f578() { return(578); }
+int f579() { return(579); }
+int f580() { return(580); }
+int f581() { return(581); }
+int f582() { return(582); }
+int f583() { return(583); }
+int f584() { return(584); }
+int f585() { return(585); }
+int f586() { return(586); }
+int f587() { return(587); }
+int f588() { return(588); }
+int f589() { return(589); }
+int f590() { return(590); }
+int f591() { return(591); }
+int f592() { return(592); }
+int f593() { return(593); }
+int f594() { return(594); }
+int f595() { return(595); }
+int f596() { return(596); }
+int f597() { return(597); }
+int f598() { return(598); }
+int f599() { return(599); }
+int f600() { return(600); }
+int f601() { return(601); }
+int f602() { return(602); }
+int f603() { return(603); }
+int f604() { return(604); }
+int f605() { return(605); }
+int f606() { return(606); }
+int f607() { return(607); }
+int f608() { return(608); }
+int f609() { return(609); }
+int f610() { return(610); }
+int f611() { return(611); }
+int f612() { return(612); }
+int f613() { return(613); }
+int f614() { return(614); }
+int f615() { return(615); }
+int f616() { return(616); }
+int f617() { return(617); }
+int f618() { return(618); }
+int f619() { return(619); }
+int f620() { return(620); }
+int f621() { return(621); }
+int f622() { return(622); }
+int f623() { return(623); }
+int f624() { return(624); }
+int f625() { return(625); }
+int f626() { return(626); }
+int f627() { return(627); }
+int f628() { return(628); }
+int f629() { return(629); }
+int f630() { return(630); }
+int f631() { return(631); }
+int f632() { return(632); }
+int f633() { return(633); }
+int f634() { return(634); }
+int f635() { return(635); }
+int f636() { return(636); }
+int f637() { return(637); }
+int f638() { return(638); }
+int f639() { return(639); }
+int f640() { return(640); }
+int f641() { return(641); }
+int f642() { return(642); }
+int f643() { return(643); }
+int f644() { return(644); }
+int f645() { return(645); }
+int f646() { return(646); }
+int f647() { return(647); }
+int f648() { return(648); }
+int f649() { return(649); }
+int f650() { return(650); }
+int f651() { return(651); }
+int f652() { return(652); }
+int f653() { return(653); }
+int f654() { return(654); }
+int f655() { return(655); }
+int f656() { return(656); }
+int f657() { return(657); }
+int f658() { return(658); }
+int f659() { return(659); }
+int f660() { return(660); }
+int f661() { return(661); }
+int f662() { return(662); }
+int f663() { return(663); }
+int f664() { return(664); }
+int f665() { return(665); }
+int f666() { return(666); }
+int f667() { return(667); }
+int f668() { return(668); }
+int f669() { return(669); }
+int f670() { return(670); }
+int f671() { return(671); }
+int f672() { return(672); }
+int f673() { return(673); }
+int f674() { return(674); }
+int f675() { return(675); }
+int f676() { return(676); }
+int f677() { return(677); }
+int f678() { return(678); }
+int f679() { return(679); }
+int f680() { return(680); }
+int f681() { return(681); }
+int f682() { return(682); }
+int f683() { return(683); }
+int f684() { return(684); }
+int f685() { return(685); }
+int f686() { return(686); }
+int f687() { return(687); }
+int f688() { return(688); }
+int f689() { return(689); }
+int f690() { return(690); }
+int f691() { return(691); }
+int f692() { return(692); }
+int f693() { return(693); }
+int f694() { return(694); }
+int f695() { return(695); }
+int f696() { return(696); }
+int f697() { return(697); }
+int f698() { return(698); }
+int f699() { return(699); }
+int f700() { return(700); }
+int f701() { return(701); }
+int f702() { return(702); }
+int f703() { return(703); }
+int f704() { return(704); }
+int f705() { return(705); }
+int f706() { return(706); }
+int f707() { return(707); }
+int f708() { return(708); }
+int f709() { return(709); }
+int f710() { return(710); }
+int f711() { return(711); }
+int f712() { return(712); }
+int f713() { return(713); }
+int f714() { return(714); }
+int f715() { return(715); }
+int f716() { return(716); }
+int f717() { return(717); }
+int f718() { return(718); }
+int f719() { return(719); }
+int f720() { return(720); }
+int f721() { return(721); }
+int f722() { return(722); }
+int f723() { return(723); }
+int f724() { return(724); }
+int f725() { return(725); }
+int f726() { return(726); }
+int f727() { return(727); }
+int f728() { return(728); }
+int f729() { return(729); }
+int f730() { return(730); }
+int f731() { return(731); }
+int f732() { return(732); }
+int f733() { return(733); }
+int f734() { return(734); }
+int f735() { return(735); }
+int f736() { return(736); }
+int f737() { return(737); }
+int f738() { return(738); }
+int f739() { return(739); }
+int f740() { return(740); }
+int f741() { return(741); }
+int f742() { return(742); }
+int f743() { return(743); }
+int f744() { return(744); }
+int f745() { return(745); }
+int f746() { return(746); }
+int f747() { return(747); }
+int f748() { return(748); }
+int f749() { return(749); }
+int f750() { return(750); }
+int f751() { return(751); }
+int f752() { return(752); }
+int f753() { return(753); }
+int f754() { return(754); }
+int f755() { return(755); }
+int f756() { return(756); }
+int f757() { return(757); }
+int f758() { return(758); }
+int f759() { return(759); }
+int f760() { return(760); }
+int f761() { return(761); }
+int f762() { return(762); }
+int f763() { return(763); }
+int f764() { return(764); }
+int f765() { return(765); }
+int f766() { return(766); }
+int f767() { return(767); }
+int f768() { return(768); }
+int f769() { return(769); }
+int f770() { return(770); }
+int f771() { return(771); }
+int f772() { return(772); }
+int f773() { return(773); }
+int f774() { return(774); }
+int f775() { return(775); }
+int f776() { return(776); }
+int f777() { return(777); }
+int f778() { return(778); }
+int f779() { return(779); }
+int f780() { return(780); }
+int f781() { return(781); }
+int f782() { return(782); }
+int f783() { return(783); }
+int f784() { return(784); }
+int f785() { return(785); }
+int f786() { return(786); }
+int f787() { return(787); }
+int f788() { return(788); }
+int f789() { return(789); }
+int f790() { return(790); }
+int f791() { return(791); }
+int f792() { return(792); }
+int f793() { return(793); }
+int f794() { return(794); }
+int f795() { return(795); }
+int f796() { return(796); }
+int f797() { return(797); }
+int f798() { return(798); }
+int f799() { return(799); }
+int f800() { return(800); }
+int f801() { return(801); }
+int f802() { return(802); }
+int f803() { return(803); }
+int f804() { return(804); }
+int f805() { return(805); }
+int f806() { return(806); }
+int f807() { return(807); }
+int f808() { return(808); }
+int f809() { return(809); }
+int f810() { return(810); }
+int f811() { return(811); }
+int f812() { return(812); }
+int f813() { return(813); }
+int f814() { return(814); }
+int f815() { return(815); }
+int f816() { return(816); }
+int f817() { return(817); }
+int f818() { return(818); }
+int f819() { return(819); }
+int f820() { return(820); }
+int f821() { return(821); }
+int f822() { return(822); }
+int f823() { return(823); }
+int f824() { return(824); }
+int f825() { return(825); }
+int f826() { return(826); }
+int f827() { return(827); }
+int f828() { return(828); }
+int f829() { return(829); }
+int f830() { return(830); }
+int f831() { return(831); }
+int f832() { return(832); }
+int f833() { return(833); }
+int f834() { return(834); }
+int f835() { return(835); }
+int f836() { return(836); }
+int f837() { return(837); }
+int f838() { return(838); }
+int f839() { return(839); }
+int f840() { return(840); }
+int f841() { return(841); }
+int f842() { return(842); }
+int f843() { return(843); }
+int f844() { return(844); }
+int f845() { return(845); }
+int f846() { return(846); }
+int f847() { return(847); }
+int f848() { return(848); }
+int f849() { return(849); }
+int f850() { return(850); }
+int f851() { return(851); }
+int f852() { return(852); }
+int f853() { return(853); }
+int f854() { return(854); }
+int f855() { return(855); }
+int f856() { return(856); }
+int f857() { return(857); }
+int f858() { return(858); }
+int f859() { return(859); }
+int f860() { return(860); }
+int f861() { return(861); }
+int f862() { return(862); }
+int f863() { return(863); }
+int f864() { return(864); }
+int f865() { return(865); }
+int f866() { return(866); }
+int f867() { return(867); }
+int f868() { return(868); }
+int f869() { return(869); }
+int f870() { return(870); }
+int f871() { return(871); }
+int f872() { return(872); }
+int f873() { return(873); }
+int f874() { return(874); }
+int f875() { return(875); }
+int f876() { return(876); }
+int f877() { return(877); }
+int f878() { return(878); }
+int f879() { return(879); }
+int f880() { return(880); }
+int f881() { return(881); }
+int f882() { return(882); }
+int f883() { return(883); }
+int f884() { return(884); }
+int f885() { return(885); }
+int f886() { return(886); }
+int f887() { return(887); }
+int f888() { return(888); }
+int f889() { return(889); }
+int f890() { return(890); }
+int f891() { return(891); }
+int f892() { return(892); }
+int f893() { return(893); }
+int f894() { return(894); }
+int f895() { return(895); }
+int f896() { return(896); }
+int f897() { return(897); }
+int f898() { return(898); }
+int f899() { return(899); }
+int f900() { return(900); }
+int f901() { return(901); }
+int f902() { return(902); }
+int f903() { return(903); }
+int f904() { return(904); }
+int f905() { return(905); }
+int f906() { return(906); }
+int f907() { return(907); }
+int f908() { return(908); }
+int f909() { return(909); }
+int f910() { return(910); }
+int f911() { return(911); }
+int f912() { return(912); }
+int f913() { return(913); }
+int f914() { return(914); }
+int f915() { return(915); }
+int f916() { return(916); }
+int f917() { return(917); }
+int f918() { return(918); }
+int f919() { return(919); }
+int f920() { return(920); }
+int f921() { return(921); }
+int f922() { return(922); }
+int f923() { return(923); }
+int f924() { return(924); }
+int f925() { return(925); }
+int f926() { return(926); }
+int f927() { return(927); }
+int f928() { return(928); }
+int f929() { return(929); }
+int f930() { return(930); }
+int f931() { return(931); }
+int f932() { return(932); }
+int f933() { return(933); }
+int f934() { return(934); }
+int f935() { return(935); }
+int f936() { return(936); }
+int f937() { return(937); }
+int f938() { return(938); }
+int f939() { return(939); }
+int f940() { return(940); }
+int f941() { return(941); }
+int f942() { return(942); }
+int f943() { return(943); }
+int f944() { return(944); }
+int f945() { return(945); }
+int f946() { return(946); }
+int f947() { return(947); }
+int f948() { return(948); }
+int f949() { return(949); }
+int f950() { return(950); }
+int f951() { return(951); }
+int f952() { return(952); }
+int f953() { return(953); }
+int f954() { return(954); }
+int f955() { return(955); }
+int f956() { return(956); }
+int f957() { return(957); }
+int f958() { return(958); }
+int f959() { return(959); }
+int f960() { return(960); }
+int f961() { return(961); }
+int f962() { return(962); }
+int f963() { return(963); }
+int f964() { return(964); }
+int f965() { return(965); }
+int f966() { return(966); }
+int f967() { return(967); }
+int f968() { return(968); }
+int f969() { return(969); }
+int f970() { return(970); }
+int f971() { return(971); }
+int f972() { return(972); }
+int f973() { return(973); }
+int f974() { return(974); }
+int f975() { return(975); }
+int f976() { return(976); }
+int f977() { return(977); }
+int f978() { return(978); }
+int f979() { return(979); }
+int f980() { return(980); }
+int f981() { return(981); }
+int f982() { return(982); }
+int f983() { return(983); }
+int f984() { return(984); }
+int f985() { return(985); }
+int f986() { return(986); }
+int f987() { return(987); }
+int f988() { return(988); }
+int f989() { return(989); }
+int f990() { return(990); }
+int f991() { return(991); }
+int f992() { return(992); }
+int f993() { return(993); }
+int f994() { return(994); }
+int f995() { return(995); }
+int f996() { return(996); }
+int f997() { return(997); }
+int f998() { return(998); }
+int f999() { return(999); }
+int f1000() { return(1000); }
+int f1001() { return(1001); }
+int f1002() { return(1002); }
+int f1003() { return(1003); }
+int f1004() { return(1004); }
+int f1005() { return(1005); }
+int f1006() { return(1006); }
+int f1007() { return(1007); }
+int f1008() { return(1008); }
+int f1009() { return(1009); }
+int f1010() { return(1010); }
+int f1011() { return(1011); }
+int f1012() { return(1012); }
+int f1013() { return(1013); }
+int f1014() { return(1014); }
+int f1015() { return(1015); }
+int f1016() { return(1016); }
+int f1017() { return(1017); }
+int f1018() { return(1018); }
+int f1019() { return(1019); }
+int f1020() { return(1020); }
+int f1021() { return(1021); }
+int f1022() { return(1022); }
+int f1023() { return(1023); }
+int f1024() { return(1024); }
+int f1025() { return(1025); }
+int f1026() { return(1026); }
+int f1027() { return(1027); }
+int f1028() { return(1028); }
+int f1029() { return(1029); }
+int f1030() { return(1030); }
+int f1031() { return(1031); }
+int f1032() { return(1032); }
+int f1033() { return(1033); }
+int f1034() { return(1034); }
+int f1035() { return(1035); }
+int f1036() { return(1036); }
+int f1037() { return(1037); }
+int f1038() { return(1038); }
+int f1039() { return(1039); }
+int f1040() { return(1040); }
+int f1041() { return(1041); }
+int f1042() { return(1042); }
+int f1043() { return(1043); }
+int f1044() { return(1044); }
+int f1045() { return(1045); }
+int f1046() { return(1046); }
+int f1047() { return(1047); }
+int f1048() { return(1048); }
+int f1049() { return(1049); }
+int f1050() { return(1050); }
+int f1051() { return(1051); }
+int f1052() { return(1052); }
+int f1053() { return(1053); }
+int f1054() { return(1054); }
+int f1055() { return(1055); }
+int f1056() { return(1056); }
+int f1057() { return(1057); }
+int f1058() { return(1058); }
+int f1059() { return(1059); }
+int f1060() { return(1060); }
+int f1061() { return(1061); }
+int f1062() { return(1062); }
+int f1063() { return(1063); }
+int f1064() { return(1064); }
+int f1065() { return(1065); }
+int f1066() { return(1066); }
+int f1067() { return(1067); }
+int f1068() { return(1068); }
+int f1069() { return(1069); }
+int f1070() { return(1070); }
+int f1071() { return(1071); }
+int f1072() { return(1072); }
+int f1073() { return(1073); }
+int f1074() { return(1074); }
+int f1075() { return(1075); }
+int f1076() { return(1076); }
+int f1077() { return(1077); }
+int f1078() { return(1078); }
+int f1079() { return(1079); }
+int f1080() { return(1080); }
+int f1081() { return(1081); }
+int f1082() { return(1082); }
+int f1083() { return(1083); }
+int f1084() { return(1084); }
+int f1085() { return(1085); }
+int f1086() { return(1086); }
+int f1087() { return(1087); }
+int f1088() { return(1088); }
+int f1089() { return(1089); }
+int f1090() { return(1090); }
+int f1091() { return(1091); }
+int f1092() { return(1092); }
+int f1093() { return(1093); }
+int f1094() { return(1094); }
+int f1095() { return(1095); }
+int f1096() { return(1096); }
+int f1097() { return(1097); }
+int f1098() { return(1098); }
+int f1099() { return(1099); }
+int f1100() { return(1100); }
+int f1101() { return(1101); }
+int f1102() { return(1102); }
+int f1103() { return(1103); }
+int f1104() { return(1104); }
+int f1105() { return(1105); }
+int f1106() { return(1106); }
+int f1107() { return(1107); }
+int f1108() { return(1108); }
+int f1109() { return(1109); }
+int f1110() { return(1110); }
+int f1111() { return(1111); }
+int f1112() { return(1112); }
+int f1113() { return(1113); }
+int f1114() { return(1114); }
+int f1115() { return(1115); }
+int f1116() { return(1116); }
+int f1117() { return(1117); }
+int f1118() { return(1118); }
+int f1119() { return(1119); }
+int f1120() { return(1120); }
+int f1121() { return(1121); }
+int f1122() { return(1122); }
+int f1123() { return(1123); }
+int f1124() { return(1124); }
+int f1125() { return(1125); }
+int f1126() { return(1126); }
+int f1127() { return(1127); }
+int f1128() { return(1128); }
+int f1129() { return(1129); }
+int f1130() { return(1130); }
+int f1131() { return(1131); }
+int f1132() { return(1132); }
+int f1133() { return(1133); }
+int f1134() { return(1134); }
+int f1135() { return(1135); }
+int f1136() { return(1136); }
+int f1137() { return(1137); }
+int f1138() { return(1138); }
+int f1139() { return(1139); }
+int f1140() { return(1140); }
+int f1141() { return(1141); }
+int f1142() { return(1142); }
+int f1143() { return(1143); }
+int f1144() { return(1144); }
+int f1145() { return(1145); }
+int f1146() { return(1146); }
+int f1147() { return(1147); }
+int f1148() { return(1148); }
+int f1149() { return(1149); }
+int f1150() { return(1150); }
+int f1151() { return(1151); }
+int f1152() { return(1152); }
+int f1153() { return(1153); }
+int f1154() { return(1154); }
+int f1155() { return(1155); }
+int f1156() { return(1156); }
+int f1157() { return(1157); }
+int f1158() { return(1158); }
+int f1159() { return(1159); }
+int f1160() { return(1160); }
+int f1161() { return(1161); }
+int f1162() { return(1162); }
+int f1163() { return(1163); }
+int f1164() { return(1164); }
+int f1165() { return(1165); }
+int f1166() { return(1166); }
+int f1167() { return(1167); }
+int f1168() { return(1168); }
+int f1169() { return(1169); }
+int f1170() { return(1170); }
+int f1171() { return(1171); }
+int f1172() { return(1172); }
+int f1173() { return(1173); }
+int f1174() { return(1174); }
+int f1175() { return(1175); }
+int f1176() { return(1176); }
+int f1177() { return(1177); }
+int f1178() { return(1178); }
+int f1179() { return(1179); }
+int f1180() { return(1180); }
+int f1181() { return(1181); }
+int f1182() { return(1182); }
+int f1183() { return(1183); }
+int f1184() { return(1184); }
+int f1185() { return(1185); }
+int f1186() { return(1186); }
+int f1187() { return(1187); }
+int f1188() { return(1188); }
+int f1189() { return(1189); }
+int f1190() { return(1190); }
+int f1191() { return(1191); }
+int f1192() { return(1192); }
+int f1193() { return(1193); }
+int f1194() { return(1194); }
+int f1195() { return(1195); }
+int f1196() { return(1196); }
+int f1197() { return(1197); }
+int f1198() { return(1198); }
+int f1199() { return(1199); }
+int f1200() { return(1200); }
+int f1201() { return(1201); }
+int f1202() { return(1202); }
+int f1203() { return(1203); }
+int f1204() { return(1204); }
+int f1205() { return(1205); }
+int f1206() { return(1206); }
+int f1207() { return(1207); }
+int f1208() { return(1208); }
+int f1209() { return(1209); }
+int f1210() { return(1210); }
+int f1211() { return(1211); }
+int f1212() { return(1212); }
+int f1213() { return(1213); }
+int f1214() { return(1214); }
+int f1215() { return(1215); }
+int f1216() { return(1216); }
+int f1217() { return(1217); }
+int f1218() { return(1218); }
+int f1219() { return(1219); }
+int f1220() { return(1220); }
+int f1221() { return(1221); }
+int f1222() { return(1222); }
+int f1223() { return(1223); }
+int f1224() { return(1224); }
+int f1225() { return(1225); }
+int f1226() { return(1226); }
+int f1227() { return(1227); }
+int f1228() { return(1228); }
+int f1229() { return(1229); }
+int f1230() { return(1230); }
+int f1231() { return(1231); }
+int f1232() { return(1232); }
+int f1233() { return(1233); }
+int f1234() { return(1234); }
+int f1235() { return(1235); }
+int f1236() { return(1236); }
+int f1237() { return(1237); }
+int f1238() { return(1238); }
+int f1239() { return(1239); }
+int f1240() { return(1240); }
+int f1241() { return(1241); }
+int f1242() { return(1242); }
+int f1243() { return(1243); }
+int f1244() { return(1244); }
+int f1245() { return(1245); }
+int f1246() { return(1246); }
+int f1247() { return(1247); }
+int f1248() { return(1248); }
+int f1249() { return(1249); }
+int f1250() { return(1250); }
+int f1251() { return(1251); }
+int f1252() { return(1252); }
+int f1253() { return(1253); }
+int f1254() { return(1254); }
+int f1255() { return(1255); }
+int f1256() { return(1256); }
+int f1257() { return(1257); }
+int f1258() { return(1258); }
+int f1259() { return(1259); }
+int f1260() { return(1260); }
+int f1261() { return(1261); }
+int f1262() { return(1262); }
+int f1263() { return(1263); }
+int f1264() { return(1264); }
+int f1265() { return(1265); }
+int f1266() { return(1266); }
+int f1267() { return(1267); }
+int f1268() { return(1268); }
+int f1269() { return(1269); }
+int f1270() { return(1270); }
+int f1271() { return(1271); }
+int f1272() { return(1272); }
+int f1273() { return(1273); }
+int f1274() { return(1274); }
+int f1275() { return(1275); }
+int f1276() { return(1276); }
+int f1277() { return(1277); }
+int f1278() { return(1278); }
+int f1279() { return(1279); }
+int f1280() { return(1280); }
+int f1281() { return(1281); }
+int f1282() { return(1282); }
+int f1283() { return(1283); }
+int f1284() { return(1284); }
+int f1285() { return(1285); }
+int f1286() { return(1286); }
+int f1287() { return(1287); }
+int f1288() { return(1288); }
+int f1289() { return(1289); }
+int f1290() { return(1290); }
+int f1291() { return(1291); }
+int f1292() { return(1292); }
+int f1293() { return(1293); }
+int f1294() { return(1294); }
+int f1295() { return(1295); }
+int f1296() { return(1296); }
+int f1297() { return(1297); }
+int f1298() { return(1298); }
+int f1299() { return(1299); }
+int f1300() { return(1300); }
+int f1301() { return(1301); }
+int f1302() { return(1302); }
+int f1303() { return(1303); }
+int f1304() { return(1304); }
+int f1305() { return(1305); }
+int f1306() { return(1306); }
+int f1307() { return(1307); }
+int f1308() { return(1308); }
+int f1309() { return(1309); }
+int f1310() { return(1310); }
+int f1311() { return(1311); }
+int f1312() { return(1312); }
+int f1313() { return(1313); }
+int f1314() { return(1314); }
+int f1315() { return(1315); }
+int f1316() { return(1316); }
+int f1317() { return(1317); }
+int f1318() { return(1318); }
+int f1319() { return(1319); }
+int f1320() { return(1320); }
+int f1321() { return(1321); }
+int f1322() { return(1322); }
+int f1323() { return(1323); }
+int f1324() { return(1324); }
+int f1325() { return(1325); }
+int f1326() { return(1326); }
+int f1327() { return(1327); }
+int f1328() { return(1328); }
+int f1329() { return(1329); }
+int f1330() { return(1330); }
+int f1331() { return(1331); }
+int f1332() { return(1332); }
+int f1333() { return(1333); }
+int f1334() { return(1334); }
+int f1335() { return(1335); }
+int f1336() { return(1336); }
+int f1337() { return(1337); }
+int f1338() { return(1338); }
+int f1339() { return(1339); }
+int f1340() { return(1340); }
+int f1341() { return(1341); }
+int f1342() { return(1342); }
+int f1343() { return(1343); }
+int f1344() { return(1344); }
+int f1345() { return(1345); }
+int f1346() { return(1346); }
+int f1347() { return(1347); }
+int f1348() { return(1348); }
+int f1349() { return(1349); }
+int f1350() { return(1350); }
+int f1351() { return(1351); }
+int f1352() { return(1352); }
+int f1353() { return(1353); }
+int f1354() { return(1354); }
+int f1355() { return(1355); }
+int f1356() { return(1356); }
+int f1357() { return(1357); }
+int f1358() { return(1358); }
+int f1359() { return(1359); }
+int f1360() { return(1360); }
+int f1361() { return(1361); }
+int f1362() { return(1362); }
+int f1363() { return(1363); }
+int f1364() { return(1364); }
+int f1365() { return(1365); }
+int f1366() { return(1366); }
+int f1367() { return(1367); }
+int f1368() { return(1368); }
+int f1369() { return(1369); }
+int f1370() { return(1370); }
+int f1371() { return(1371); }
+int f1372() { return(1372); }
+int f1373() { return(1373); }
+int f1374() { return(1374); }
+int f1375() { return(1375); }
+int f1376() { return(1376); }
+int f1377() { return(1377); }
+int f1378() { return(1378); }
+int f1379() { return(1379); }
+int f1380() { return(1380); }
+int f1381() { return(1381); }
+int f1382() { return(1382); }
+int f1383() { return(1383); }
+int f1384() { return(1384); }
+int f1385() { return(1385); }
+int f1386() { return(1386); }
+int f1387() { return(1387); }
+int f1388() { return(1388); }
+int f1389() { return(1389); }
+int f1390() { return(1390); }
+int f1391() { return(1391); }
+int f1392() { return(1392); }
+int f1393() { return(1393); }
+int f1394() { return(1394); }
+int f1395() { return(1395); }
+int f1396() { return(1396); }
+int f1397() { return(1397); }
+int f1398() { return(1398); }
+int f1399() { return(1399); }
+int f1400() { return(1400); }
+int f1401() { return(1401); }
+int f1402() { return(1402); }
+int f1403() { return(1403); }
+int f1404() { return(1404); }
+int f1405() { return(1405); }
+int f1406() { return(1406); }
+int f1407() { return(1407); }
+int f1408() { return(1408); }
+int f1409() { return(1409); }
+int f1410() { return(1410); }
+int f1411() { return(1411); }
+int f1412() { return(1412); }
+int f1413() { return(1413); }
+int f1414() { return(1414); }
+int f1415() { return(1415); }
+int f1416() { return(1416); }
+int f1417() { return(1417); }
+int f1418() { return(1418); }
+int f1419() { return(1419); }
+int f1420() { return(1420); }
+int f1421() { return(1421); }
+int f1422() { return(1422); }
+int f1423() { return(1423); }
+int f1424() { return(1424); }
+int f1425() { return(1425); }
+int f1426() { return(1426); }
+int f1427() { return(1427); }
+int f1428() { return(1428); }
+int f1429() { return(1429); }
+int f1430() { return(1430); }
+int f1431() { return(1431); }
+int f1432() { return(1432); }
+int f1433() { return(1433); }
+int f1434() { return(1434); }
+int f1435() { return(1435); }
+int f1436() { return(1436); }
+int f1437() { return(1437); }
+int f1438() { return(1438); }
+int f1439() { return(1439); }
+int f1440() { return(1440); }
+int f1441() { return(1441); }
+int f1442() { return(1442); }
+int f1443() { return(1443); }
+int f1444() { return(1444); }
+int f1445() { return(1445); }
+int f1446() { return(1446); }
+int f1447() { return(1447); }
+int f1448() { return(1448); }
+int f1449() { return(1449); }
+int f1450() { return(1450); }
+int f1451() { return(1451); }
+int f1452() { return(1452); }
+int f1453() { return(1453); }
+int f1454() { return(1454); }
+int f1455() { return(1455); }
+int f1456() { return(1456); }
+int f1457() { return(1457); }
+int f1458() { return(1458); }
+int f1459() { return(1459); }
+int f1460() { return(1460); }
+int f1461() { return(1461); }
+int f1462() { return(1462); }
+int f1463() { return(1463); }
+int f1464() { return(1464); }
+int f1465() { return(1465); }
+int f1466() { return(1466); }
+int f1467() { return(1467); }
+int f1468() { return(1468); }
+int f1469() { return(1469); }
+int f1470() { return(1470); }
+int f1471() { return(1471); }
+int f1472() { return(1472); }
+int f1473() { return(1473); }
+int f1474() { return(1474); }
+int f1475() { return(1475); }
+int f1476() { return(1476); }
+int f1477() { return(1477); }
+int f1478() { return(1478); }
+int f1479() { return(1479); }
+int f1480() { return(1480); }
+int f1481() { return(1481); }
+int f1482() { return(1482); }
+int f1483() { return(1483); }
+int f1484() { return(1484); }
+int f1485() { return(1485); }
+int f1486() { return(1486); }
+int f1487() { return(1487); }
+int f1488() { return(1488); }
+int f1489() { return(1489); }
+int f1490() { return(1490); }
+int f1491() { return(1491); }
+int f1492() { return(1492); }
+int f1493() { return(1493); }
+int f1494() { return(1494); }
+int f1495() { return(1495); }
+int f1496() { return(1496); }
+int f1497() { return(1497); }
+int f1498() { return(1498); }
+int f1499() { return(1499); }
+int f1500() { return(1500); }
+int f1501() { return(1501); }
+int f1502() { return(1502); }
+int f1503() { return(1503); }
+int f1504() { return(1504); }
+int f1505() { return(1505); }
+int f1506() { return(1506); }
+int f1507() { return(1507); }
+int f1508() { return(1508); }
+int f1509() { return(1509); }
+int f1510() { return(1510); }
+int f1511() { return(1511); }
+int f1512() { return(1512); }
+int f1513() { return(1513); }
+int f1514() { return(1514); }
+int f1515() { return(1515); }
+int f1516() { return(1516); }
+int f1517() { return(1517); }
+int f1518() { return(1518); }
+int f1519() { return(1519); }
+int f1520() { return(1520); }
+int f1521() { return(1521); }
+int f1522() { return(1522); }
+int f1523() { return(1523); }
+int f1524() { return(1524); }
+int f1525() { return(1525); }
+int f1526() { return(1526); }
+int f1527() { return(1527); }
+int f1528() { return(1528); }
+int f1529() { return(1529); }
+int f1530() { return(1530); }
+int f1531() { return(1531); }
+int f1532() { return(1532); }
+int f1533() { return(1533); }
+int f1534() { return(1534); }
+int f1535() { return(1535); }
+int f1536() { return(1536); }
+int f1537() { return(1537); }
+int f1538() { return(1538); }
+int f1539() { return(1539); }
+int f1540() { return(1540); }
+int f1541() { return(1541); }
+int f1542() { return(1542); }
+int f1543() { return(1543); }
+int f1544() { return(1544); }
+int f1545() { return(1545); }
+int f1546() { return(1546); }
+int f1547() { return(1547); }
+int f1548() { return(1548); }
+int f1549() { return(1549); }
+int f1550() { return(1550); }
+int f1551() { return(1551); }
+int f1552() { return(1552); }
+int f1553() { return(1553); }
+int f1554() { return(1554); }
+int f1555() { return(1555); }
+int f1556() { return(1556); }
+int f1557() { return(1557); }
+int f1558() { return(1558); }
+int f1559() { return(1559); }
+int f1560() { return(1560); }
+int f1561() { return(1561); }
+int f1562() { return(1562); }
+int f1563() { return(1563); }
+int f1564() { return(1564); }
+int f1565() { return(1565); }
+int f1566() { return(1566); }
+int f1567() { return(1567); }
+int f1568() { return(1568); }
+int f1569() { return(1569); }
+int f1570() { return(1570); }
+int f1571() { return(1571); }
+int f1572() { return(1572); }
+int f1573() { return(1573); }
+int f1574() { return(1574); }
+int f1575() { return(1575); }
+int f1576() { return(1576); }
+int f1577() { return(1577); }
+int f1578() { return(1578); }
+int f1579() { return(1579); }
+int f1580() { return(1580); }
+int f1581() { return(1581); }
+int f1582() { return(1582); }
+int f1583() { return(1583); }
+int f1584() { return(1584); }
+int f1585() { return(1585); }
+int f1586() { return(1586); }
+int f1587() { return(1587); }
+int f1588() { return(1588); }
+int f1589() { return(1589); }
+int f1590() { return(1590); }
+int f1591() { return(1591); }
+int f1592() { return(1592); }
+int f1593() { return(1593); }
+int f1594() { return(1594); }
+int f1595() { return(1595); }
+int f1596() { return(1596); }
+int f1597() { return(1597); }
+int f1598() { return(1598); }
+int f1599() { return(1599); }
+int f1600() { return(1600); }
+int f1601() { return(1601); }
+int f1602() { return(1602); }
+int f1603() { return(1603); }
+int f1604() { return(1604); }
+int f1605() { return(1605); }
+int f1606() { return(1606); }
+int f1607() { return(1607); }
+int f1608() { return(1608); }
+int f1609() { return(1609); }
+int f1610() { return(1610); }
+int f1611() { return(1611); }
+int f1612() { return(1612); }
+int f1613() { return(1613); }
+int f1614() { return(1614); }
+int f1615() { return(1615); }
+int f1616() { return(1616); }
+int f1617() { return(1617); }
+int f1618() { return(1618); }
+int f1619() { return(1619); }
+int f1620() { return(1620); }
+int f1621() { return(1621); }
+int f1622() { return(1622); }
+int f1623() { return(1623); }
+int f1624() { return(1624); }
+int f1625() { return(1625); }
+int f1626() { return(1626); }
+int f1627() { return(1627); }
+int f1628() { return(1628); }
+int f1629() { return(1629); }
+int f1630() { return(1630); }
+int f1631() { return(1631); }
+int f1632() { return(1632); }
+int f1633() { return(1633); }
+int f1634() { return(1634); }
+int f1635() { return(1635); }
+int f1636() { return(1636); }
+int f1637() { return(1637); }
+int f1638() { return(1638); }
+int f1639() { return(1639); }
+int f1640() { return(1640); }
+int f1641() { return(1641); }
+int f1642() { return(1642); }
+int f1643() { return(1643); }
+int f1644() { return(1644); }
+int f1645() { return(1645); }
+int f1646() { return(1646); }
+int f1647() { return(1647); }
+int f1648() { return(1648); }
+int f1649() { return(1649); }
+int f1650() { return(1650); }
+int f1651() { return(1651); }
+int f1652() { return(1652); }
+int f1653() { return(1653); }
+int f1654() { return(1654); }
+int f1655() { return(1655); }
+int f1656() { return(1656); }
+int f1657() { return(1657); }
+int f1658() { return(1658); }
+int f1659() { return(1659); }
+int f1660() { return(1660); }
+int f1661() { return(1661); }
+int f1662() { return(1662); }
+int f1663() { return(1663); }
+int f1664() { return(1664); }
+int f1665() { return(1665); }
+int f1666() { return(1666); }
+int f1667() { return(1667); }
+int f1668() { return(1668); }
+int f1669() { return(1669); }
+int f1670() { return(1670); }
+int f1671() { return(1671); }
+int f1672() { return(1672); }
+int f1673() { return(1673); }
+int f1674() { return(1674); }
+int f1675() { return(1675); }
+int f1676() { return(1676); }
+int f1677() { return(1677); }
+int f1678() { return(1678); }
+int f1679() { return(1679); }
+int f1680() { return(1680); }
+int f1681() { return(1681); }
+int f1682() { return(1682); }
+int f1683() { return(1683); }
+int f1684() { return(1684); }
+int f1685() { return(1685); }
+int f1686() { return(1686); }
+int f1687() { return(1687); }
+int f1688() { return(1688); }
+int f1689() { return(1689); }
+int f1690() { return(1690); }
+int f1691() { return(1691); }
+int f1692() { return(1692); }
+int f1693() { return(1693); }
+int f1694() { return(1694); }
+int f1695() { return(1695); }
+int f1696() { return(1696); }
+int f1697() { return(1697); }
+int f1698() { return(1698); }
+int f1699() { return(1699); }
+int f1700() { return(1700); }
+int f1701() { return(1701); }
+int f1702() { return(1702); }
+int f1703() { return(1703); }
+int f1704() { return(1704); }
+int f1705() { return(1705); }
+int f1706() { return(1706); }
+int f1707() { return(1707); }
+int f1708() { return(1708); }
+int f1709() { return(1709); }
+int f1710() { return(1710); }
+int f1711() { return(1711); }
+int f1712() { return(1712); }
+int f1713() { return(1713); }
+int f1714() { return(1714); }
+int f1715() { return(1715); }
+int f1716() { return(1716); }
+int f1717() { return(1717); }
+int f1718() { return(1718); }
+int f1719() { return(1719); }
+int f1720() { return(1720); }
+int f1721() { return(1721); }
+int f1722() { return(1722); }
+int f1723() { return(1723); }
+int f1724() { return(1724); }
+int f1725() { return(1725); }
+int f1726() { return(1726); }
+int f1727() { return(1727); }
+int f1728() { return(1728); }
+int f1729() { return(1729); }
+int f1730() { return(1730); }
+int f1731() { return(1731); }
+int f1732() { return(1732); }
+int f1733() { return(1733); }
+int f1734() { return(1734); }
+int f1735() { return(1735); }
+int f1736() { return(1736); }
+int f1737() { return(1737); }
+int f1738() { return(1738); }
+int f1739() { return(1739); }
+int f1740() { return(1740); }
+int f1741() { return(1741); }
+int f1742() { return(1742); }
+int f1743() { return(1743); }
+int f1744() { return(1744); }
+int f1745() { return(1745); }
+int f1746() { return(1746); }
+int f1747() { return(1747); }
+int f1748() { return(1748); }
+int f1749() { return(1749); }
+int f1750() { return(1750); }
+int f1751() { return(1751); }
+int f1752() { return(1752); }
+int f1753() { return(1753); }
+int f1754() { return(1754); }
+int f1755() { return(1755); }
+int f1756() { return(1756); }
+int f1757() { return(1757); }
+int f1758() { return(1758); }
+int f1759() { return(1759); }
+int f1760() { return(1760); }
+int f1761() { return(1761); }
+int f1762() { return(1762); }
+int f1763() { return(1763); }
+int f1764() { return(1764); }
+int f1765() { return(1765); }
+int f1766() { return(1766); }
+int f1767() { return(1767); }
+int f1768() { return(1768); }
+int f1769() { return(1769); }
+int f1770() { return(1770); }
+int f1771() { return(1771); }
+int f1772() { return(1772); }
+int f1773() { return(1773); }
+int f1774() { return(1774); }
+int f1775() { return(1775); }
+int f1776() { return(1776); }
+int f1777() { return(1777); }
+int f1778() { return(1778); }
+int f1779() { return(1779); }
+int f1780() { return(1780); }
+int f1781() { return(1781); }
+int f1782() { return(1782); }
+int f1783() { return(1783); }
+int f1784() { return(1784); }
+int f1785() { return(1785); }
+int f1786() { return(1786); }
+int f1787() { return(1787); }
+int f1788() { return(1788); }
+int f1789() { return(1789); }
+int f1790() { return(1790); }
+int f1791() { return(1791); }
+int f1792() { return(1792); }
+int f1793() { return(1793); }
+int f1794() { return(1794); }
+int f1795() { return(1795); }
+int f1796() { return(1796); }
+int f1797() { return(1797); }
+int f1798() { return(1798); }
+int f1799() { return(1799); }
+int f1800() { return(1800); }
+int f1801() { return(1801); }
+int f1802() { return(1802); }
+int f1803() { return(1803); }
+int f1804() { return(1804); }
+int f1805() { return(1805); }
+int f1806() { return(1806); }
+int f1807() { return(1807); }
+int f1808() { return(1808); }
+int f1809() { return(1809); }
+int f1810() { return(1810); }
+int f1811() { return(1811); }
+int f1812() { return(1812); }
+int f1813() { return(1813); }
+int f1814() { return(1814); }
+int f1815() { return(1815); }
+int f1816() { return(1816); }
+int f1817() { return(1817); }
+int f1818() { return(1818); }
+int f1819() { return(1819); }
+int f1820() { return(1820); }
+int f1821() { return(1821); }
+int f1822() { return(1822); }
+int f1823() { return(1823); }
+int f1824() { return(1824); }
+int f1825() { return(1825); }
+int f1826() { return(1826); }
+int f1827() { return(1827); }
+int f1828() { return(1828); }
+int f1829() { return(1829); }
+int f1830() { return(1830); }
+int f1831() { return(1831); }
+int f1832() { return(1832); }
+int f1833() { return(1833); }
+int f1834() { return(1834); }
+int f1835() { return(1835); }
+int f1836() { return(1836); }
+int f1837() { return(1837); }
+int f1838() { return(1838); }
+int f1839() { return(1839); }
+int f1840() { return(1840); }
+int f1841() { return(1841); }
+int f1842() { return(1842); }
+int f1843() { return(1843); }
+int f1844() { return(1844); }
+int f1845() { return(1845); }
+int f1846() { return(1846); }
+int f1847() { return(1847); }
+int f1848() { return(1848); }
+int f1849() { return(1849); }
+int f1850() { return(1850); }
+int f1851() { return(1851); }
+int f1852() { return(1852); }
+int f1853() { return(1853); }
+int f1854() { return(1854); }
+int f1855() { return(1855); }
+int f1856() { return(1856); }
+int f1857() { return(1857); }
+int f1858() { return(1858); }
+int f1859() { return(1859); }
+int f1860() { return(1860); }
+int f1861() { return(1861); }
+int f1862() { return(1862); }
+int f1863() { return(1863); }
+int f1864() { return(1864); }
+int f1865() { return(1865); }
+int f1866() { return(1866); }
+int f1867() { return(1867); }
+int f1868() { return(1868); }
+int f1869() { return(1869); }
+int f1870() { return(1870); }
+int f1871() { return(1871); }
+int f1872() { return(1872); }
+int f1873() { return(1873); }
+int f1874() { return(1874); }
+int f1875() { return(1875); }
+int f1876() { return(1876); }
+int f1877() { return(1877); }
+int f1878() { return(1878); }
+int f1879() { return(1879); }
+int f1880() { return(1880); }
+int f1881() { return(1881); }
+int f1882() { return(1882); }
+int f1883() { return(1883); }
+int f1884() { return(1884); }
+int f1885() { return(1885); }
+int f1886() { return(1886); }
+int f1887() { return(1887); }
+int f1888() { return(1888); }
+int f1889() { return(1889); }
+int f1890() { return(1890); }
+int f1891() { return(1891); }
+int f1892() { return(1892); }
+int f1893() { return(1893); }
+int f1894() { return(1894); }
+int f1895() { return(1895); }
+int f1896() { return(1896); }
+int f1897() { return(1897); }
+int f1898() { return(1898); }
+int f1899() { return(1899); }
+int f1900() { return(1900); }
+int f1901() { return(1901); }
+int f1902() { return(1902); }
+int f1903() { return(1903); }
+int f1904() { return(1904); }
+int f1905() { return(1905); }
+int f1906() { return(1906); }
+int f1907() { return(1907); }
+int f1908() { return(1908); }
+int f1909() { return(1909); }
+int f1910() { return(1910); }
+int f1911() { return(1911); }
+int f1912() { return(1912); }
+int f1913() { return(1913); }
+int f1914() { return(1914); }
+int f1915() { return(1915); }
+int f1916() { return(1916); }
+int f1917() { return(1917); }
+int f1918() { return(1918); }
+int f1919() { return(1919); }
+int f1920() { return(1920); }
+int f1921() { return(1921); }
+int f1922() { return(1922); }
+int f1923() { return(1923); }
+int f1924() { return(1924); }
+int f1925() { return(1925); }
+int f1926() { return(1926); }
+int f1927() { return(1927); }
+int f1928() { return(1928); }
+int f1929() { return(1929); }
+int f1930() { return(1930); }
+int f1931() { return(1931); }
+int f1932() { return(1932); }
+int f1933() { return(1933); }
+int f1934() { return(1934); }
+int f1935() { return(1935); }
+int f1936() { return(1936); }
+int f1937() { return(1937); }
+int f1938() { return(1938); }
+int f1939() { return(1939); }
+int f1940() { return(1940); }
+int f1941() { return(1941); }
+int f1942() { return(1942); }
+int f1943() { return(1943); }
+int f1944() { return(1944); }
+int f1945() { return(1945); }
+int f1946() { return(1946); }
+int f1947() { return(1947); }
+int f1948() { return(1948); }
+int f1949() { return(1949); }
+int f1950() { return(1950); }
+int f1951() { return(1951); }
+int f1952() { return(1952); }
+int f1953() { return(1953); }
+int f1954() { return(1954); }
+int f1955() { return(1955); }
+int f1956() { return(1956); }
+int f1957() { return(1957); }
+int f1958() { return(1958); }
+int f1959() { return(1959); }
+int f1960() { return(1960); }
+int f1961() { return(1961); }
+int f1962() { return(1962); }
+int f1963() { return(1963); }
+int f1964() { return(1964); }
+int f1965() { return(1965); }
+int f1966() { return(1966); }
+int f1967() { return(1967); }
+int f1968() { return(1968); }
+int f1969() { return(1969); }
+int f1970() { return(1970); }
+int f1971() { return(1971); }
+int f1972() { return(1972); }
+int f1973() { return(1973); }
+int f1974() { return(1974); }
+int f1975() { return(1975); }
+int f1976() { return(1976); }
+int f1977() { return(1977); }
+int f1978() { return(1978); }
+int f1979() { return(1979); }
+int f1980() { return(1980); }
+int f1981() { return(1981); }
+int f1982() { return(1982); }
+int f1983() { return(1983); }
+int f1984() { return(1984); }
+int f1985() { return(1985); }
+int f1986() { return(1986); }
+int f1987() { return(1987); }
+int f1988() { return(1988); }
+int f1989() { return(1989); }
+int f1990() { return(1990); }
+int f1991() { return(1991); }
+int f1992() { return(1992); }
+int f1993() { return(1993); }
+int f1994() { return(1994); }
+int f1995() { return(1995); }
+int f1996() { return(1996); }
+int f1997() { return(1997); }
+int f1998() { return(1998); }
+int f1999() { return(1999); }
+int f2000() { return(2000); }
+int f2001() { return(2001); }
+int f2002() { return(2002); }
+int f2003() { return(2003); }
+int f2004() { return(2004); }
+int f2005() { return(2005); }
+int f2006() { return(2006); }
+int f2007() { return(2007); }
+int f2008() { return(2008); }
+int f2009() { return(2009); }
+int f2010() { return(2010); }
+int f2011() { return(2011); }
+int f2012() { return(2012); }
+int f2013() { return(2013); }
+int f2014() { return(2014); }
+int f2015() { return(2015); }
+int f2016() { return(2016); }
+int f2017() { return(2017); }
+int f2018() { return(2018); }
+int f2019() { return(2019); }
+int f2020() { return(2020); }
+int f2021() { return(2021); }
+int f2022() { return(2022); }
+int f2023() { return(2023); }
+int f2024() { return(2024); }
+int f2025() { return(2025); }
+int f2026() { return(2026); }
+int f2027() { return(2027); }
+int f2028() { return(2028); }
+int f2029() { return(2029); }
+int f2030() { return(2030); }
+int f2031() { return(2031); }
+int f2032() { return(2032); }
+int f2033() { return(2033); }
+int f2034() { return(2034); }
+int f2035() { return(2035); }
+int f2036() { return(2036); }
+int f2037() { return(2037); }
+int f2038() { return(2038); }
+int f2039() { return(2039); }
+int f2040() { return(2040); }
+int f2041() { return(2041); }
+int f2042() { return(2042); }
+int f2043() { return(2043); }
+int f2044() { return(2044); }
+int f2045() { return(2045); }
+int f2046() { return(2046); }
+int f2047() { return(2047); }
+int f2048() { return(2048); }
+int f2049() { return(2049); }
+int f2050() { return(2050); }
+int f2051() { return(2051); }
+int f2052() { return(2052); }
+int f2053() { return(2053); }
+int f2054() { return(2054); }
+int f2055() { return(2055); }
+int f2056() { return(2056); }
+int f2057() { return(2057); }
+int f2058() { return(2058); }
+int f2059() { return(2059); }
+int f2060() { return(2060); }
+int f2061() { return(2061); }
+int f2062() { return(2062); }
+int f2063() { return(2063); }
+int f2064() { return(2064); }
+int f2065() { return(2065); }
+int f2066() { return(2066); }
+int f2067() { return(2067); }
+int f2068() { return(2068); }
+int f2069() { return(2069); }
+int f2070() { return(2070); }
+int f2071() { return(2071); }
+int f2072() { return(2072); }
+int f2073() { return(2073); }
+int f2074() { return(2074); }
+int f2075() { return(2075); }
+int f2076() { return(2076); }
+int f2077() { return(2077); }
+int f2078() { return(2078); }
+int f2079() { return(2079); }
+int f2080() { return(2080); }
+int f2081() { return(2081); }
+int f2082() { return(2082); }
+int f2083() { return(2083); }
+int f2084() { return(2084); }
+int f2085() { return(2085); }
+int f2086() { return(2086); }
+int f2087() { return(2087); }
+int f2088() { return(2088); }
+int f2089() { return(2089); }
+int f2090() { return(2090); }
+int f2091() { return(2091); }
+int f2092() { return(2092); }
+int f2093() { return(2093); }
+int f2094() { return(2094); }
+int f2095() { return(2095); }
+int f2096() { return(2096); }
+int f2097() { return(2097); }
+int f2098() { return(2098); }
+int f2099() { return(2099); }
+int f2100() { return(2100); }
+int f2101() { return(2101); }
+int f2102() { return(2102); }
+int f2103() { return(2103); }
+int f2104() { return(2104); }
+int f2105() { return(2105); }
+int f2106() { return(2106); }
+int f2107() { return(2107); }
+int f2108() { return(2108); }
+int f2109() { return(2109); }
+int f2110() { return(2110); }
+int f2111() { return(2111); }
+int f2112() { return(2112); }
+int f2113() { return(2113); }
+int f2114() { return(2114); }
+int f2115() { return(2115); }
+int f2116() { return(2116); }
+int f2117() { return(2117); }
+int f2118() { return(2118); }
+int f2119() { return(2119); }
+int f2120() { return(2120); }
+int f2121() { return(2121); }
+int f2122() { return(2122); }
+int f2123() { return(2123); }
+int f2124() { return(2124); }
+int f2125() { return(2125); }
+int f2126() { return(2126); }
+int f2127() { return(2127); }
+int f2128() { return(2128); }
+int f2129() { return(2129); }
+int f2130() { return(2130); }
+int f2131() { return(2131); }
+int f2132() { return(2132); }
+int f2133() { return(2133); }
+int f2134() { return(2134); }
+int f2135() { return(2135); }
+int f2136() { return(2136); }
+int f2137() { return(2137); }
+int f2138() { return(2138); }
+int f2139() { return(2139); }
+int f2140() { return(2140); }
+int f2141() { return(2141); }
+int f2142() { return(2142); }
+int f2143() { return(2143); }
+int f2144() { return(2144); }
+int f2145() { return(2145); }
+int f2146() { return(2146); }
+int f2147() { return(2147); }
+int f2148() { return(2148); }
+int f2149() { return(2149); }
+int f2150() { return(2150); }
+int f2151() { return(2151); }
+int f2152() { return(2152); }
+int f2153() { return(2153); }
+int f2154() { return(2154); }
+int f2155() { return(2155); }
+int f2156() { return(2156); }
+int f2157() { return(2157); }
+int f2158() { return(2158); }
+int f2159() { return(2159); }
+int f2160() { return(2160); }
+int f2161() { return(2161); }
+int f2162() { return(2162); }
+int f2163() { return(2163); }
+int f2164() { return(2164); }
+int f2165() { return(2165); }
+int f2166() { return(2166); }
+int f2167() { return(2167); }
+int f2168() { return(2168); }
+int f2169() { return(2169); }
+int f2170() { return(2170); }
+int f2171() { return(2171); }
+int f2172() { return(2172); }
+int f2173() { return(2173); }
+int f2174() { return(2174); }
+int f2175() { return(2175); }
+int f2176() { return(2176); }
+int f2177() { return(2177); }
+int f2178() { return(2178); }
+int f2179() { return(2179); }
+int f2180() { return(2180); }
+int f2181() { return(2181); }
+int f2182() { return(2182); }
+int f2183() { return(2183); }
+int f2184() { return(2184); }
+int f2185() { return(2185); }
+int f2186() { return(2186); }
+int f2187() { return(2187); }
+int f2188() { return(2188); }
+int f2189() { return(2189); }
+int f2190() { return(2190); }
+int f2191() { return(2191); }
+int f2192() { return(2192); }
+int f2193() { return(2193); }
+int f2194() { return(2194); }
+int f2195() { return(2195); }
+int f2196() { return(2196); }
+int f2197() { return(2197); }
+int f2198() { return(2198); }
+int f2199() { return(2199); }
+int f2200() { return(2200); }
+int f2201() { return(2201); }
+int f2202() { return(2202); }
+int f2203() { return(2203); }
+int f2204() { return(2204); }
+int f2205() { return(2205); }
+int f2206() { return(2206); }
+int f2207() { return(2207); }
+int f2208() { return(2208); }
+int f2209() { return(2209); }
+int f2210() { return(2210); }
+int f2211() { return(2211); }
+int f2212() { return(2212); }
+int f2213() { return(2213); }
+int f2214() { return(2214); }
+int f2215() { return(2215); }
+int f2216() { return(2216); }
+int f2217() { return(2217); }
+int f2218() { return(2218); }
+int f2219() { return(2219); }
+int f2220() { return(2220); }
+int f2221() { return(2221); }
+int f2222() { return(2222); }
+int f2223() { return(2223); }
+int f2224() { return(2224); }
+int f2225() { return(2225); }
+int f2226() { return(2226); }
+int f2227() { return(2227); }
+int f2228() { return(2228); }
+int f2229() { return(2229); }
+int f2230() { return(2230); }
+int f2231() { return(2231); }
+int f2232() { return(2232); }
+int f2233() { return(2233); }
+int f2234() { return(2234); }
+int f2235() { return(2235); }
+int f2236() { return(2236); }
+int f2237() { return(2237); }
+int f2238() { return(2238); }
+int f2239() { return(2239); }
+int f2240() { return(2240); }
+int f2241() { return(2241); }
+int f2242() { return(2242); }
+int f2243() { return(2243); }
+int f2244() { return(2244); }
+int f2245() { return(2245); }
+int f2246() { return(2246); }
+int f2247() { return(2247); }
+int f2248() { return(2248); }
+int f2249() { return(2249); }
+int f2250() { return(2250); }
+int f2251() { return(2251); }
+int f2252() { return(2252); }
+int f2253() { return(2253); }
+int f2254() { return(2254); }
+int f2255() { return(2255); }
+int f2256() { return(2256); }
+int f2257() { return(2257); }
+int f2258() { return(2258); }
+int f2259() { return(2259); }
+int f2260() { return(2260); }
+int f2261() { return(2261); }
+int f2262() { return(2262); }
+int f2263() { return(2263); }
+int f2264() { return(2264); }
+int f2265() { return(2265); }
+int f2266() { return(2266); }
+int f2267() { return(2267); }
+int f2268() { return(2268); }
+int f2269() { return(2269); }
+int f2270() { return(2270); }
+int f2271() { return(2271); }
+int f2272() { return(2272); }
+int f2273() { return(2273); }
+int f2274() { return(2274); }
+int f2275() { return(2275); }
+int f2276() { return(2276); }
+int f2277() { return(2277); }
+int f2278() { return(2278); }
+int f2279() { return(2279); }
+int f2280() { return(2280); }
+int f2281() { return(2281); }
+int f2282() { return(2282); }
+int f2283() { return(2283); }
+int f2284() { return(2284); }
+int f2285() { return(2285); }
+int f2286() { return(2286); }
+int f2287() { return(2287); }
+int f2288() { return(2288); }
+int f2289() { return(2289); }
+int f2290() { return(2290); }
+int f2291() { return(2291); }
+int f2292() { return(2292); }
+int f2293() { return(2293); }
+int f2294() { return(2294); }
+int f2295() { return(2295); }
+int f2296() { return(2296); }
+int f2297() { return(2297); }
+int f2298() { return(2298); }
+int f2299() { return(2299); }
+int f2300() { return(2300); }
+int f2301() { return(2301); }
+int f2302() { return(2302); }
+int f2303() { return(2303); }
+int f2304() { return(2304); }
+int f2305() { return(2305); }
+int f2306() { return(2306); }
+int f2307() { return(2307); }
+int f2308() { return(2308); }
+int f2309() { return(2309); }
+int f2310() { return(2310); }
+int f2311() { return(2311); }
+int f2312() { return(2312); }
+int f2313() { return(2313); }
+int f2314() { return(2314); }
+int f2315() { return(2315); }
+int f2316() { return(2316); }
+int f2317() { return(2317); }
+int f2318() { return(2318); }
+int f2319() { return(2319); }
+int f2320() { return(2320); }
+int f2321() { return(2321); }
+int f2322() { return(2322); }
+int f2323() { return(2323); }
+int f2324() { return(2324); }
+int f2325() { return(2325); }
+int f2326() { return(2326); }
+int f2327() { return(2327); }
+int f2328() { return(2328); }
+int f2329() { return(2329); }
+int f2330() { return(2330); }
+int f2331() { return(2331); }
+int f2332() { return(2332); }
+int f2333() { return(2333); }
+int f2334() { return(2334); }
+int f2335() { return(2335); }
+int f2336() { return(2336); }
+int f2337() { return(2337); }
+int f2338() { return(2338); }
+int f2339() { return(2339); }
+int f2340() { return(2340); }
+int f2341() { return(2341); }
+int f2342() { return(2342); }
+int f2343() { return(2343); }
+int f2344() { return(2344); }
+int f2345() { return(2345); }
+int f2346() { return(2346); }
+int f2347() { return(2347); }
+int f2348() { return(2348); }
+int f2349() { return(2349); }
+int f2350() { return(2350); }
+int f2351() { return(2351); }
+int f2352() { return(2352); }
+int f2353() { return(2353); }
+int f2354() { return(2354); }
+int f2355() { return(2355); }
+int f2356() { return(2356); }
+int f2357() { return(2357); }
+int f2358() { return(2358); }
+int f2359() { return(2359); }
+int f2360() { return(2360); }
+int f2361() { return(2361); }
+int f2362() { return(2362); }
+int f2363() { return(2363); }
+int f2364() { return(2364); }
+int f2365() { return(2365); }
+int f2366() { return(2366); }
+int f2367() { return(2367); }
+int f2368() { return(2368); }
+int f2369() { return(2369); }
+int f2370() { return(2370); }
+int f2371() { return(2371); }
+int f2372() { return(2372); }
+int f2373() { return(2373); }
+int f2374() { return(2374); }
+int f2375() { return(2375); }
+int f2376() { return(2376); }
+int f2377() { return(2377); }
+int f2378() { return(2378); }
+int f2379() { return(2379); }
+int f2380() { return(2380); }
+int f2381() { return(2381); }
+int f2382() { return(2382); }
+int f2383() { return(2383); }
+int f2384() { return(2384); }
+int f2385() { return(2385); }
+int f2386() { return(2386); }
+int f2387() { return(2387); }
+int f2388() { return(2388); }
+int f2389() { return(2389); }
+int f2390() { return(2390); }
+int f2391() { return(2391); }
+int f2392() { return(2392); }
+int f2393() { return(2393); }
+int f2394() { return(2394); }
+int f2395() { return(2395); }
+int f2396() { return(2396); }
+int f2397() { return(2397); }
+int f2398() { return(2398); }
+int f2399() { return(2399); }
+int f2400() { return(2400); }
+int f2401() { return(2401); }
+int f2402() { return(2402); }
+int f2403() { return(2403); }
+int f2404() { return(2404); }
+int f2405() { return(2405); }
+int f2406() { return(2406); }
+int f2407() { return(2407); }
+int f2408() { return(2408); }
+int f2409() { return(2409); }
+int f2410() { return(2410); }
+int f2411() { return(2411); }
+int f2412() { return(2412); }
+int f2413() { return(2413); }
+int f2414() { return(2414); }
+int f2415() { return(2415); }
+int f2416() { return(2416); }
+int f2417() { return(2417); }
+int f2418() { return(2418); }
+int f2419() { return(2419); }
+int f2420() { return(2420); }
+int f2421() { return(2421); }
+int f2422() { return(2422); }
+int f2423() { return(2423); }
+int f2424() { return(2424); }
+int f2425() { return(2425); }
+int f2426() { return(2426); }
+int f2427() { return(2427); }
+int f2428() { return(2428); }
+int f2429() { return(2429); }
+int f2430() { return(2430); }
+int f2431() { return(2431); }
+int f2432() { return(2432); }
+int f2433() { return(2433); }
+int f2434() { return(2434); }
+int f2435() { return(2435); }
+int f2436() { return(2436); }
+int f2437() { return(2437); }
+int f2438() { return(2438); }
+int f2439() { return(2439); }
+int f2440() { return(2440); }
+int f2441() { return(2441); }
+int f2442() { return(2442); }
+int f2443() { return(2443); }
+int f2444() { return(2444); }
+int f2445() { return(2445); }
+int f2446() { return(2446); }
+int f2447() { return(2447); }
+int f2448() { return(2448); }
+int f2449() { return(2449); }
+int f2450() { return(2450); }
+int f2451() { return(2451); }
+int f2452() { return(2452); }
+int f2453() { return(2453); }
+int f2454() { return(2454); }
+int f2455() { return(2455); }
+int f2456() { return(2456); }
+int f2457() { return(2457); }
+int f2458() { return(2458); }
+int f2459() { return(2459); }
+int f2460() { return(2460); }
+int f2461() { return(2461); }
+int f2462() { return(2462); }
+int f2463() { return(2463); }
+int f2464() { return(2464); }
+int f2465() { return(2465); }
+int f2466() { return(2466); }
+int f2467() { return(2467); }
+int f2468() { return(2468); }
+int f2469() { return(2469); }
+int f2470() { return(2470); }
+int f2471() { return(2471); }
+int f2472() { return(2472); }
+int f2473() { return(2473); }
+int f2474() { return(2474); }
+int f2475() { return(2475); }
+int f2476() { return(2476); }
+int f2477() { return(2477); }
+int f2478() { return(2478); }
+int f2479() { return(2479); }
+int f2480() { return(2480); }
+int f2481() { return(2481); }
+int f2482() { return(2482); }
+int f2483() { return(2483); }
+int f2484() { return(2484); }
+int f2485() { return(2485); }
+int f2486() { return(2486); }
+int f2487() { return(2487); }
+int f2488() { return(2488); }
+int f2489() { return(2489); }
+int f2490() { return(2490); }
+int f2491() { return(2491); }
+int f2492() { return(2492); }
+int f2493() { return(2493); }
+int f2494() { return(2494); }
+int f2495() { return(2495); }
+int f2496() { return(2496); }
+int f2497() { return(2497); }
+int f2498() { return(2498); }
+int f2499() { return(2499); }
+int f2500() { return(2500); }
+int f2501() { return(2501); }
+int f2502() { return(2502); }
+int f2503() { return(2503); }
+int f2504() { return(2504); }
+int f2505() { return(2505); }
+int f2506() { return(2506); }
+int f2507() { return(2507); }
+int f2508() { return(2508); }
+int f2509() { return(2509); }
+int f2510() { return(2510); }
+int f2511() { return(2511); }
+int f2512() { return(2512); }
+int f2513() { return(2513); }
+int f2514() { return(2514); }
+int f2515() { return(2515); }
+int f2516() { return(2516); }
+int f2517() { return(2517); }
+int f2518() { return(2518); }
+int f2519() { return(2519); }
+int f2520() { return(2520); }
+int f2521() { return(2521); }
+int f2522() { return(2522); }
+int f2523() { return(2523); }
+int f2524() { return(2524); }
+int f2525() { return(2525); }
+int f2526() { return(2526); }
+int f2527() { return(2527); }
+int f2528() { return(2528); }
+int f2529() { return(2529); }
+int f2530() { return(2530); }
+int f2531() { return(2531); }
+int f2532() { return(2532); }
+int f2533() { return(2533); }
+int f2534() { return(2534); }
+int f2535() { return(2535); }
+int f2536() { return(2536); }
+int f2537() { return(2537); }
+int f2538() { return(2538); }
+int f2539() { return(2539); }
+int f2540() { return(2540); }
+int f2541() { return(2541); }
+int f2542() { return(2542); }
+int f2543() { return(2543); }
+int f2544() { return(2544); }
+int f2545() { return(2545); }
+int f2546() { return(2546); }
+int f2547() { return(2547); }
+int f2548() { return(2548); }
+int f2549() { return(2549); }
+int f2550() { return(2550); }
+int f2551() { return(2551); }
+int f2552() { return(2552); }
+int f2553() { return(2553); }
+int f2554() { return(2554); }
+int f2555() { return(2555); }
+int f2556() { return(2556); }
+int f2557() { return(2557); }
+int f2558() { return(2558); }
+int f2559() { return(2559); }
+int f2560() { return(2560); }
+int f2561() { return(2561); }
+int f2562() { return(2562); }
+int f2563() { return(2563); }
+int f2564() { return(2564); }
+int f2565() { return(2565); }
+int f2566() { return(2566); }
+int f2567() { return(2567); }
+int f2568() { return(2568); }
+int f2569() { return(2569); }
+int f2570() { return(2570); }
+int f2571() { return(2571); }
+int f2572() { return(2572); }
+int f2573() { return(2573); }
+int f2574() { return(2574); }
+int f2575() { return(2575); }
+int f2576() { return(2576); }
+int f2577() { return(2577); }
+int f2578() { return(2578); }
+int f2579() { return(2579); }
+int f2580() { return(2580); }
+int f2581() { return(2581); }
+int f2582() { return(2582); }
+int f2583() { return(2583); }
+int f2584() { return(2584); }
+int f2585() { return(2585); }
+int f2586() { return(2586); }
+int f2587() { return(2587); }
+int f2588() { return(2588); }
+int f2589() { return(2589); }
+int f2590() { return(2590); }
+int f2591() { return(2591); }
+int f2592() { return(2592); }
+int f2593() { return(2593); }
+int f2594() { return(2594); }
+int f2595() { return(2595); }
+int f2596() { return(2596); }
+int f2597() { return(2597); }
+int f2598() { return(2598); }
+int f2599() { return(2599); }
+int f2600() { return(2600); }
+int f2601() { return(2601); }
+int f2602() { return(2602); }
+int f2603() { return(2603); }
+int f2604() { return(2604); }
+int f2605() { return(2605); }
+int f2606() { return(2606); }
+int f2607() { return(2607); }
+int f2608() { return(2608); }
+int f2609() { return(2609); }
+int f2610() { return(2610); }
+int f2611() { return(2611); }
+int f2612() { return(2612); }
+int f2613() { return(2613); }
+int f2614() { return(2614); }
+int f2615() { return(2615); }
+int f2616() { return(2616); }
+int f2617() { return(2617); }
+int f2618() { return(2618); }
+int f2619() { return(2619); }
+int f2620() { return(2620); }
+int f2621() { return(2621); }
+int f2622() { return(2622); }
+int f2623() { return(2623); }
+int f2624() { return(2624); }
+int f2625() { return(2625); }
+int f2626() { return(2626); }
+int f2627() { return(2627); }
+int f2628() { return(2628); }
+int f2629() { return(2629); }
+int f2630() { return(2630); }
+int f2631() { return(2631); }
+int f2632() { return(2632); }
+int f2633() { return(2633); }
+int f2634() { return(2634); }
+int f2635() { return(2635); }
+int f2636() { return(2636); }
+int f2637() { return(2637); }
+int f2638() { return(2638); }
+int f2639() { return(2639); }
+int f2640() { return(2640); }
+int f2641() { return(2641); }
+int f2642() { return(2642); }
+int f2643() { return(2643); }
+int f2644() { return(2644); }
+int f2645() { return(2645); }
+int f2646() { return(2646); }
+int f2647() { return(2647); }
+int f2648() { return(2648); }
+int f2649() { return(2649); }
+int f2650() { return(2650); }
+int f2651() { return(2651); }
+int f2652() { return(2652); }
+int f2653() { return(2653); }
+int f2654() { return(2654); }
+int f2655() { return(2655); }
+int f2656() { return(2656); }
+int f2657() { return(2657); }
+int f2658() { return(2658); }
+int f2659() { return(2659); }
+int f2660() { return(2660); }
+int f2661() { return(2661); }
+int f2662() { return(2662); }
+int f2663() { return(2663); }
+int f2664() { return(2664); }
+int f2665() { return(2665); }
+int f2666() { return(2666); }
+int f2667() { return(2667); }
+int f2668() { return(2668); }
+int f2669() { return(2669); }
+int f2670() { return(2670); }
+int f2671() { return(2671); }
+int f2672() { return(2672); }
+int f2673() { return(2673); }
+int f2674() { return(2674); }
+int f2675() { return(2675); }
+int f2676() { return(2676); }
+int f2677() { return(2677); }
+int f2678() { return(2678); }
+int f2679() { return(2679); }
+int f2680() { return(2680); }
+int f2681() { return(2681); }
+int f2682() { return(2682); }
+int f2683() { return(2683); }
+int f2684() { return(2684); }
+int f2685() { return(2685); }
+int f2686() { return(2686); }
+int f2687() { return(2687); }
+int f2688() { return(2688); }
+int f2689() { return(2689); }
+int f2690() { return(2690); }
+int f2691() { return(2691); }
+int f2692() { return(2692); }
+int f2693() { return(2693); }
+int f2694() { return(2694); }
+int f2695() { return(2695); }
+int f2696() { return(2696); }
+int f2697() { return(2697); }
+int f2698() { return(2698); }
+int f2699() { return(2699); }
+int f2700() { return(2700); }
+int f2701() { return(2701); }
+int f2702() { return(2702); }
+int f2703() { return(2703); }
+int f2704() { return(2704); }
+int f2705() { return(2705); }
+int f2706() { return(2706); }
+int f2707() { return(2707); }
+int f2708() { return(2708); }
+int f2709() { return(2709); }
+int f2710() { return(2710); }
+int f2711() { return(2711); }
+int f2712() { return(2712); }
+int f2713() { return(2713); }
+int f2714() { return(2714); }
+int f2715() { return(2715); }
+int f2716() { return(2716); }
+int f2717() { return(2717); }
+int f2718() { return(2718); }
+int f2719() { return(2719); }
+int f2720() { return(2720); }
+int f2721() { return(2721); }
+int f2722() { return(2722); }
+int f2723() { return(2723); }
+int f2724() { return(2724); }
+int f2725() { return(2725); }
+int f2726() { return(2726); }
+int f2727() { return(2727); }
+int f2728() { return(2728); }
+int f2729() { return(2729); }
+int f2730() { return(2730); }
+int f2731() { return(2731); }
+int f2732() { return(2732); }
+int f2733() { return(2733); }
+int f2734() { return(2734); }
+int f2735() { return(2735); }
+int f2736() { return(2736); }
+int f2737() { return(2737); }
+int f2738() { return(2738); }
+int f2739() { return(2739); }
+int f2740() { return(2740); }
+int f2741() { return(2741); }
+int f2742() { return(2742); }
+int f2743() { return(2743); }
+int f2744() { return(2744); }
+int f2745() { return(2745); }
+int f2746() { return(2746); }
+int f2747() { return(2747); }
+int f2748() { return(2748); }
+int f2749() { return(2749); }
+int f2750() { return(2750); }
+int f2751() { return(2751); }
+int f2752() { return(2752); }
+int f2753() { return(2753); }
+int f2754() { return(2754); }
+int f2755() { return(2755); }
+int f2756() { return(2756); }
+int f2757() { return(2757); }
+int f2758() { return(2758); }
+int f2759() { return(2759); }
+int f2760() { return(2760); }
+int f2761() { return(2761); }
+int f2762() { return(2762); }
+int f2763() { return(2763); }
+int f2764() { return(2764); }
+int f2765() { return(2765); }
+int f2766() { return(2766); }
+int f2767() { return(2767); }
+int f2768() { return(2768); }
+int f2769() { return(2769); }
+int f2770() { return(2770); }
+int f2771() { return(2771); }
+int f2772() { return(2772); }
+int f2773() { return(2773); }
+int f2774() { return(2774); }
+int f2775() { return(2775); }
+int f2776() { return(2776); }
+int f2777() { return(2777); }
+int f2778() { return(2778); }
+int f2779() { return(2779); }
+int f2780() { return(2780); }
+int f2781() { return(2781); }
+int f2782() { return(2782); }
+int f2783() { return(2783); }
+int f2784() { return(2784); }
+int f2785() { return(2785); }
+int f2786() { return(2786); }
+int f2787() { return(2787); }
+int f2788() { return(2788); }
+int f2789() { return(2789); }
+int f2790() { return(2790); }
+int f2791() { return(2791); }
+int f2792() { return(2792); }
+int f2793() { return(2793); }
+int f2794() { return(2794); }
+int f2795() { return(2795); }
+int f2796() { return(2796); }
+int f2797() { return(2797); }
+int f2798() { return(2798); }
+int f2799() { return(2799); }
+int f2800() { return(2800); }
+int f2801() { return(2801); }
+int f2802() { return(2802); }
+int f2803() { return(2803); }
+int f2804() { return(2804); }
+int f2805() { return(2805); }
+int f2806() { return(2806); }
+int f2807() { return(2807); }
+int f2808() { return(2808); }
+int f2809() { return(2809); }
+int f2810() { return(2810); }
+int f2811() { return(2811); }
+int f2812() { return(2812); }
+int f2813() { return(2813); }
+int f2814() { return(2814); }
+int f2815() { return(2815); }
+int f2816() { return(2816); }
+int f2817() { return(2817); }
+int f2818() { return(2818); }
+int f2819() { return(2819); }
+int f2820() { return(2820); }
+int f2821() { return(2821); }
+int f2822() { return(2822); }
+int f2823() { return(2823); }
+int f2824() { return(2824); }
+int f2825() { return(2825); }
+int f2826() { return(2826); }
+int f2827() { return(2827); }
+int f2828() { return(2828); }
+int f2829() { return(2829); }
+int f2830() { return(2830); }
+int f2831() { return(2831); }
+int f2832() { return(2832); }
+int f2833() { return(2833); }
+int f2834() { return(2834); }
+int f2835() { return(2835); }
+int f2836() { return(2836); }
+int f2837() { return(2837); }
+int f2838() { return(2838); }
+int f2839() { return(2839); }
+int f2840() { return(2840); }
+int f2841() { return(2841); }
+int f2842() { return(2842); }
+int f2843() { return(2843); }
+int f2844() { return(2844); }
+int f2845() { return(2845); }
+int f2846() { return(2846); }
+int f2847() { return(2847); }
+int f2848() { return(2848); }
+int f2849() { return(2849); }
+int f2850() { return(2850); }
+int f2851() { return(2851); }
+int f2852() { return(2852); }
+int f2853() { return(2853); }
+int f2854() { return(2854); }
+int f2855() { return(2855); }
+int f2856() { return(2856); }
+int f2857() { return(2857); }
+int f2858() { return(2858); }
+int f2859() { return(2859); }
+int f2860() { return(2860); }
+int f2861() { return(2861); }
+int f2862() { return(2862); }
+int f2863() { return(2863); }
+int f2864() { return(2864); }
+int f2865() { return(2865); }
+int f2866() { return(2866); }
+int f2867() { return(2867); }
+int f2868() { return(2868); }
+int f2869() { return(2869); }
+int f2870() { return(2870); }
+int f2871() { return(2871); }
+int f2872() { return(2872); }
+int f2873() { return(2873); }
+int f2874() { return(2874); }
+int f2875() { return(2875); }
+int f2876() { return(2876); }
+int f2877() { return(2877); }
+int f2878() { return(2878); }
+int f2879() { return(2879); }
+int f2880() { return(2880); }
+int f2881() { return(2881); }
+int f2882() { return(2882); }
+int f2883() { return(2883); }
+int f2884() { return(2884); }
+int f2885() { return(2885); }
+int f2886() { return(2886); }
+int f2887() { return(2887); }
+int f2888() { return(2888); }
+int f2889() { return(2889); }
+int f2890() { return(2890); }
+int f2891() { return(2891); }
+int f2892() { return(2892); }
+int f2893() { return(2893); }
+int f2894() { return(2894); }
+int f2895() { return(2895); }
+int f2896() { return(2896); }
+int f2897() { return(2897); }
+int f2898() { return(2898); }
+int f2899() { return(2899); }
+int f2900() { return(2900); }
+int f2901() { return(2901); }
+int f2902() { return(2902); }
+int f2903() { return(2903); }
+int f2904() { return(2904); }
+int f2905() { return(2905); }
+int f2906() { return(2906); }
+int f2907() { return(2907); }
+int f2908() { return(2908); }
+int f2909() { return(2909); }
+int f2910() { return(2910); }
+int f2911() { return(2911); }
+int f2912() { return(2912); }
+int f2913() { return(2913); }
+int f2914() { return(2914); }
+int f2915() { return(2915); }
+int f2916() { return(2916); }
+int f2917() { return(2917); }
+int f2918() { return(2918); }
+int f2919() { return(2919); }
+int f2920() { return(2920); }
+int f2921() { return(2921); }
+int f2922() { return(2922); }
+int f2923() { return(2923); }
+int f2924() { return(2924); }
+int f2925() { return(2925); }
+int f2926() { return(2926); }
+int f2927() { return(2927); }
+int f2928() { return(2928); }
+int f2929() { return(2929); }
+int f2930() { return(2930); }
+int f2931() { return(2931); }
+int f2932() { return(2932); }
+int f2933() { return(2933); }
+int f2934() { return(2934); }
+int f2935() { return(2935); }
+int f2936() { return(2936); }
+int f2937() { return(2937); }
+int f2938() { return(2938); }
+int f2939() { return(2939); }
+int f2940() { return(2940); }
+int f2941() { return(2941); }
+int f2942() { return(2942); }
+int f2943() { return(2943); }
+int f2944() { return(2944); }
+int f2945() { return(2945); }
+int f2946() { return(2946); }
+int f2947() { return(2947); }
+int f2948() { return(2948); }
+int f2949() { return(2949); }
+int f2950() { return(2950); }
+int f2951() { return(2951); }
+int f2952() { return(2952); }
+int f2953() { return(2953); }
+int f2954() { return(2954); }
+int f2955() { return(2955); }
+int f2956() { return(2956); }
+int f2957() { return(2957); }
+int f2958() { return(2958); }
+int f2959() { return(2959); }
+int f2960() { return(2960); }
+int f2961() { return(2961); }
+int f2962() { return(2962); }
+int f2963() { return(2963); }
+int f2964() { return(2964); }
+int f2965() { return(2965); }
+int f2966() { return(2966); }
+int f2967() { return(2967); }
+int f2968() { return(2968); }
+int f2969() { return(2969); }
+int f2970() { return(2970); }
+int f2971() { return(2971); }
+int f2972() { return(2972); }
+int f2973() { return(2973); }
+int f2974() { return(2974); }
+int f2975() { return(2975); }
+int f2976() { return(2976); }
+int f2977() { return(2977); }
+int f2978() { return(2978); }
+int f2979() { return(2979); }
+int f2980() { return(2980); }
+int f2981() { return(2981); }
+int f2982() { return(2982); }
+int f2983() { return(2983); }
+int f2984() { return(2984); }
+int f2985() { return(2985); }
+int f2986() { return(2986); }
+int f2987() { return(2987); }
+int f2988() { return(2988); }
+int f2989() { return(2989); }
+int f2990() { return(2990); }
+int f2991() { return(2991); }
+int f2992() { return(2992); }
+int f2993() { return(2993); }
+int f2994() { return(2994); }
+int f2995() { return(2995); }
+int f2996() { return(2996); }
+int f2997() { return(2997); }
+int f2998() { return(2998); }
+int f2999() { return(2999); }
+
+int main() {
+  int x;
+  x= f7();
+  printint(x);
+  printint(f2993());
+  printint(f0());
+  printint(f2999());
+  return(0);
+}
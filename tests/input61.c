@@ -0,0 +1,5 @@
+int main() {
+ x = 1;
+ return(0);
+}
+int f() { $ }
@@ -0,0 +1,10 @@
+1
+2
+3
+4
+2
+1
+10
+11
+1
+2
@@ -0,0 +1,4 @@
+750000
+0
+5
+7
@@ -0,0 +1,5 @@
+Hello world
+world
+Hello world
+	tab and \ backslash
+rld
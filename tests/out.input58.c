@@ -0,0 +1,23 @@
+2993
+42857
+4000
+125
+232
+1007
+999
+-1000
+-1001
+0
+65
+361
+42
+201
+6
+999
+1
+0
+0
+0
+1
+42
+Done
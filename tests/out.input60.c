@@ -0,0 +1,4 @@
+7
+2993
+0
+2999
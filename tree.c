@@ -4,40 +4,103 @@
 
 // AST tree functions
 
-// Build and return a generic AST node
-struct ASTnode *mkastnode(
-    int op,
-    int type,
-    struct ASTnode *left,
-    struct ASTnode *mid,
-    struct ASTnode *right,
-    int intvalue) {
+// A function's AST is built up in `ASTbuf[]`, which grows as needed. The tree
+// is finished with once its code has been generated, so `freeASTnodes()`
+// empties the buffer for the next function and memory use is bounded by the
+// largest function. Nodes are referred to by index, so they stay put when
+// the buffer grows.
+
+#define INITIAL_ASTWORDS 4096  // Initial capacity of `ASTbuf[]`, in words
+
+static _Thread_local int ASTlen = NOAST + 2;  // Words in use in `ASTbuf[]`
+static _Thread_local int ASTcap;              // Capacity of `ASTbuf[]`, in words
+
+// Build and return a generic AST node. Only as many child indices are stored
+// as are needed to hold the last of `left`, `right` and `mid` which is there.
+int mkastnode(int op, int type, int left, int mid, int right, int intvalue) {
   struct ASTnode *n;
+  int nchild, id;
 
-  n = (struct ASTnode *)malloc(sizeof(struct ASTnode));
+  nchild = mid ? 3 : right ? 2 : left ? 1 : 0;
 
-  if (n == NULL) {
-    fatal("Unable to `malloc` in `mkastnode()");
+  if (ASTlen + 2 + nchild > ASTcap) {
+    ASTcap = ASTcap ? ASTcap * 2 : INITIAL_ASTWORDS;
+    if ((ASTbuf = realloc(ASTbuf, ASTcap * sizeof(int))) == NULL)
+      fatal("Unable to `realloc` in `mkastnode()`");
   }
 
+  id = ASTlen;
+  ASTlen += 2 + nchild;
+
   // Copy in the field values and return it
+  n = ASTNODE(id);
   n->op = op;
   n->type = type;
-  n->left = left;
-  n->mid = mid;
-  n->right = right;
+  n->flags = nchild;
   n->v.intvalue = intvalue;
-  return n;
+  if (nchild > 0)
+    n->child[0] = left;
+  if (nchild > 1)
+    n->child[1] = right;
+  if (nchild > 2)
+    n->child[2] = mid;
+  return id;
 }
 
 // Make an AST leaf node
-struct ASTnode *mkastleaf(int op, int type, int intvalue) {
-  return mkastnode(op, type, NULL, NULL, NULL, intvalue);
+int mkastleaf(int op, int type, int intvalue) {
+  return mkastnode(op, type, NOAST, NOAST, NOAST, intvalue);
 }
 
 // Make a unary AST node: only one child
-struct ASTnode *mkastunary(int op, int type, struct ASTnode *left, int intvalue) {
-  return mkastnode(op, type, left, NULL, NULL, intvalue);
+int mkastunary(int op, int type, int left, int intvalue) {
+  return mkastnode(op, type, left, NOAST, NOAST, intvalue);
+}
+
+// Return the number of words of `ASTbuf[]` in use
+int ASTsize(void) {
+  return ASTlen;
+}
+
+// Set the number of words of `ASTbuf[]` in use, growing it if needed, and
+// return it. Used to read a tree back in, see `serialize.c`.
+int *setASTsize(int nwords) {
+  if (nwords > ASTcap) {
+    ASTcap = nwords;
+    if ((ASTbuf = realloc(ASTbuf, ASTcap * sizeof(int))) == NULL)
+      fatal("Unable to `realloc` in `setASTsize()`");
+  }
+
+  ASTlen = nwords;
+  return ASTbuf;
+}
+
+// Release all the AST nodes, keeping `ASTbuf[]` for reuse
+void freeASTnodes(void) {
+  ASTlen = NOAST + 2;
+}
+
+// Release this thread's `ASTbuf[]`
+void freeASTbuf(void) {
+  free(ASTbuf);
+  ASTbuf = NULL;
+  ASTlen = NOAST + 2;
+  ASTcap = 0;
+}
+
+// Return true if the `v` field of an AST node with this op is a symbol slot
+int hassymbol(int op) {
+  switch (op) {
+    case A_IDENT:
+    case A_ADDR:
+    case A_FUNCCALL:
+    case A_FUNCTION:
+    case A_POSTINC:
+    case A_POSTDEC:
+      return 1;
+    default:
+      return 0;
+  }
 }
 
 // Generate and return a new label number
@@ -47,56 +110,18 @@ static int gendumplabel(void) {
   return id++;
 }
 
-// Given an AST tree, print it out and follow the
-// traversal of the tree that genAST() follows
-void dumpAST(struct ASTnode *n, int label, int level) {
-  int Lfalse, Lstart, Lend;
-
-  switch (n->op) {
-    case A_IF:
-      Lfalse = gendumplabel();
-      for (int i = 0; i < level; i++)
-        fprintf(stdout, " ");
-      fprintf(stdout, "A_IF");
-      if (n->right) {
-        Lend = gendumplabel();
-        fprintf(stdout, ", end L%d", Lend);
-      }
-      fprintf(stdout, "\n");
-      dumpAST(n->left, Lfalse, level + 2);
-      dumpAST(n->mid, NOLABEL, level + 2);
-      if (n->right)
-        dumpAST(n->right, NOLABEL, level + 2);
-      return;
-    case A_WHILE:
-      Lstart = gendumplabel();
-      for (int i = 0; i < level; i++)
-        fprintf(stdout, " ");
-      fprintf(stdout, "A_WHILE, start L%d\n", Lstart);
-      Lend = gendumplabel();
-      dumpAST(n->left, Lend, level + 2);
-      dumpAST(n->right, NOLABEL, level + 2);
-      return;
-  }
-
-  // Reset level to -2 for A_GLUE
-  if (n->op == A_GLUE)
-    level = -2;
-
-  // General AST node handling
-  if (n->left)
-    dumpAST(n->left, NOLABEL, level + 2);
-  if (n->right)
-    dumpAST(n->right, NOLABEL, level + 2);
+// Print out the line for a node, after its children have been printed
+static void dumpnode(int n, int level) {
+  struct ASTnode *node = ASTNODE(n);
 
   for (int i = 0; i < level; i++)
     fprintf(stdout, " ");
-  switch (n->op) {
+  switch (node->op) {
     case A_GLUE:
       fprintf(stdout, "\n\n");
       return;
     case A_FUNCTION:
-      fprintf(stdout, "A_FUNCTION %s\n", Symtable[n->v.id].name);
+      fprintf(stdout, "A_FUNCTION %s\n", SYMBOL(node->v.id)->name);
       return;
     case A_ADD:
       fprintf(stdout, "A_ADD\n");
@@ -129,13 +154,13 @@ void dumpAST(struct ASTnode *n, int label, int level) {
       fprintf(stdout, "A_GE\n");
       return;
     case A_INTLIT:
-      fprintf(stdout, "A_INTLIT %d\n", n->v.intvalue);
+      fprintf(stdout, "A_INTLIT %d\n", node->v.intvalue);
       return;
     case A_IDENT:
-      if (n->rvalue)
-        fprintf(stdout, "A_IDENT rval %s\n", Symtable[n->v.id].name);
+      if (node->flags & AST_RVALUE)
+        fprintf(stdout, "A_IDENT rval %s\n", SYMBOL(node->v.id)->name);
       else
-        fprintf(stdout, "A_IDENT %s\n", Symtable[n->v.id].name);
+        fprintf(stdout, "A_IDENT %s\n", SYMBOL(node->v.id)->name);
       return;
     case A_ASSIGN:
       fprintf(stdout, "A_ASSIGN\n");
@@ -147,21 +172,110 @@ void dumpAST(struct ASTnode *n, int label, int level) {
       fprintf(stdout, "A_RETURN\n");
       return;
     case A_FUNCCALL:
-      fprintf(stdout, "A_FUNCCALL %s\n", Symtable[n->v.id].name);
+      fprintf(stdout, "A_FUNCCALL %s\n", SYMBOL(node->v.id)->name);
       return;
     case A_ADDR:
-      fprintf(stdout, "A_ADDR %s\n", Symtable[n->v.id].name);
+      fprintf(stdout, "A_ADDR %s\n", SYMBOL(node->v.id)->name);
       return;
     case A_DEREF:
-      if (n->rvalue)
+      if (node->flags & AST_RVALUE)
         fprintf(stdout, "A_DEREF rval\n");
       else
         fprintf(stdout, "A_DEREF\n");
       return;
     case A_SCALE:
-      fprintf(stdout, "A_SCALE %d\n", n->v.size);
+      fprintf(stdout, "A_SCALE %d\n", node->v.size);
       return;
     default:
-      fatald("Unknown dumpAST operator", n->op);
+      fatald("Unknown dumpAST operator", node->op);
+  }
+}
+
+// The AST dump doesn't recurse. Pending work is kept on `Dumpstack[]`: either
+// a tree still to be visited, or a node whose line is due once its children
+// have been printed.
+
+struct dumpitem {
+  int n;      // The node
+  int level;  // Indentation level
+  int print;  // True if the node's children are done and its line is due
+};
+
+#define INITIAL_DUMPITEMS 64  // Initial capacity of `Dumpstack[]`
+
+static struct dumpitem *Dumpstack;  // Pending work for `dumpAST()`
+static int Dumpdepth;               // Number of items in use
+static int Dumpcap;                 // Capacity of `Dumpstack[]`
+
+// Push an item onto `Dumpstack[]`
+static void dumppush(int n, int level, int print) {
+  if (Dumpdepth == Dumpcap) {
+    Dumpcap = Dumpcap ? Dumpcap * 2 : INITIAL_DUMPITEMS;
+    if ((Dumpstack = realloc(Dumpstack, Dumpcap * sizeof(struct dumpitem))) == NULL)
+      fatal("Unable to `realloc` in `dumppush()`");
+  }
+
+  Dumpstack[Dumpdepth].n = n;
+  Dumpstack[Dumpdepth].level = level;
+  Dumpstack[Dumpdepth].print = print;
+  Dumpdepth++;
+}
+
+// Given an AST tree, print it out and follow the
+// traversal of the tree that genAST() follows.
+// Children are pushed in reverse so that they come off the stack in order.
+void dumpAST(int n, int level) {
+  struct dumpitem item;
+  int Lstart, Lend;
+
+  dumppush(n, level, 0);
+
+  while (Dumpdepth > 0) {
+    item = Dumpstack[--Dumpdepth];
+    n = item.n;
+    level = item.level;
+
+    if (item.print) {
+      dumpnode(n, level);
+      continue;
+    }
+
+    switch (ASTNODE(n)->op) {
+      case A_IF:
+        gendumplabel();  // The false label
+        for (int i = 0; i < level; i++)
+          fprintf(stdout, " ");
+        fprintf(stdout, "A_IF");
+        if (ASTRIGHT(n)) {
+          Lend = gendumplabel();
+          fprintf(stdout, ", end L%d", Lend);
+        }
+        fprintf(stdout, "\n");
+        if (ASTRIGHT(n))
+          dumppush(ASTRIGHT(n), level + 2, 0);
+        dumppush(ASTMID(n), level + 2, 0);
+        dumppush(ASTLEFT(n), level + 2, 0);
+        continue;
+      case A_WHILE:
+        Lstart = gendumplabel();
+        for (int i = 0; i < level; i++)
+          fprintf(stdout, " ");
+        fprintf(stdout, "A_WHILE, start L%d\n", Lstart);
+        gendumplabel();  // The end label
+        dumppush(ASTRIGHT(n), level + 2, 0);
+        dumppush(ASTLEFT(n), level + 2, 0);
+        continue;
+    }
+
+    // Reset level to -2 for A_GLUE
+    if (ASTNODE(n)->op == A_GLUE)
+      level = -2;
+
+    // General AST node handling: the children, then the node itself
+    dumppush(n, level, 1);
+    if (ASTRIGHT(n))
+      dumppush(ASTRIGHT(n), level + 2, 0);
+    if (ASTLEFT(n))
+      dumppush(ASTLEFT(n), level + 2, 0);
   }
 }
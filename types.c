@@ -68,14 +68,14 @@ int value_at(int type) {
 
 // Given an AST tree and a type that we want it to become, possibly modify the
 // tree by widening or scaling so that it is compatible with this type. Return
-// the original tree if no changes occurred, a modified tree, or NULL if the
+// the original tree if no changes occurred, a modified tree, or NOAST if the
 // tree is not compatible with the given type.
 // If this will be part of a binary operation, the AST op is not zero.
-struct ASTnode *modify_type(struct ASTnode *tree, int rtype, int op) {
+int modify_type(int tree, int rtype, int op) {
   int ltype;
   int lsize, rsize;
 
-  ltype = tree->type;
+  ltype = ASTNODE(tree)->type;
 
   // Compare scalar int types
   if (inttype(ltype) && inttype(rtype)) {
@@ -84,7 +84,7 @@ struct ASTnode *modify_type(struct ASTnode *tree, int rtype, int op) {
     lsize = genprimsize(ltype);
     rsize = genprimsize(rtype);
 
-    if (lsize > rsize) return NULL;
+    if (lsize > rsize) return NOAST;
 
     if (lsize < rsize) return mkastunary(A_WIDEN, rtype, tree, 0);
   }
@@ -107,5 +107,5 @@ struct ASTnode *modify_type(struct ASTnode *tree, int rtype, int op) {
     }
   }
 
-  return NULL;
+  return NOAST;
 }